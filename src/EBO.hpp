@@ -21,6 +21,11 @@ public:
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     }
 
+    GLuint id() const
+    {
+        return buffer;
+    }
+
     ~EBO()
     {
         glDeleteBuffers(1, &buffer);
@@ -0,0 +1,38 @@
+#ifndef FIXEDSHAPEMESH_H
+#define FIXEDSHAPEMESH_H
+
+#include "ShapeMesh.hpp"
+#include "FixedShapes.hpp"
+
+#include <cstdint>
+
+// ShapeMesh over compile-time data (see FixedShapes.hpp). The vertex and index
+// arrays live in read-only storage and go straight to glBufferData; the
+// vertices/indices vectors stay empty.
+template <const auto& data>
+class FixedShapeMesh : public ShapeMesh
+{
+public:
+    FixedShapeMesh()
+    {
+        primitive = toGLPrimitive(data.primitive);
+        setLayout(data.vertices, data.indices);
+    }
+};
+
+template <int N, float r = 1.0f, std::uint32_t seed = 0>
+class FixedCircleMesh : public FixedShapeMesh<fixedCircleData<N, r, seed>> {};
+
+template <int N, float r = 1.0f, std::uint32_t seed = 0>
+class FixedConeMesh : public FixedShapeMesh<fixedConeData<N, r, seed>> {};
+
+template <int N, float r = 0.8f, std::uint32_t seed = 0>
+class FixedCylinderMesh : public FixedShapeMesh<fixedCylinderData<N, r, seed>> {};
+
+template <int N, float r = 1.0f, std::uint32_t seed = 0>
+class FixedSphereMesh : public FixedShapeMesh<fixedSphereData<N, r, seed>> {};
+
+template <int N, float R = 0.5f, std::uint32_t seed = 0>
+class FixedTorusMesh : public FixedShapeMesh<fixedTorusData<N, R, seed>> {};
+
+#endif // FIXEDSHAPEMESH_H
@@ -0,0 +1,263 @@
+#ifndef FIXEDSHAPES_H
+#define FIXEDSHAPES_H
+
+#include "MeshData.hpp"
+#include "VertexRandom.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+
+// Compile-time counterparts of the runtime generators for resolutions known at build
+// time. The fixed*Data variable templates are evaluated by the compiler and end up as
+// read-only data in the binary: no trig, no allocation and no generation at startup.
+// Vertex order, indices, seeded colours, normals and texture coordinates match the
+// runtime shapes to float rounding; the sphere is welded like SphereMesh.
+// Keep N modest (a few hundred at most) to stay within compiler constexpr limits.
+
+template <std::size_t VertexCount, std::size_t IndexCount>
+struct FixedMeshData
+{
+    std::array<float, VertexCount * MeshData::attribCount> vertices{};
+    std::array<unsigned int, IndexCount> indices{};
+    Primitive primitive{ Primitive::Triangles };
+};
+
+// Reduces to [-pi, pi] and sums the Taylor series; accurate to double rounding there.
+constexpr double constexprSin(double x)
+{
+    constexpr double twoPi = 2.0 * std::numbers::pi;
+    x -= twoPi * static_cast<long long>(x / twoPi);
+    if (x > std::numbers::pi) {
+        x -= twoPi;
+    }
+    else if (x < -std::numbers::pi) {
+        x += twoPi;
+    }
+
+    double term = x;
+    double sum = x;
+    for (int k = 1; k < 20; ++k) {
+        term *= -x * x / ((2 * k) * (2 * k + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double constexprCos(double x)
+{
+    return constexprSin(x + std::numbers::pi / 2.0);
+}
+
+template <std::size_t V, std::size_t I>
+constexpr void setFixedVertex(FixedMeshData<V, I>& mesh, std::size_t v, std::array<float, MeshData::attribCount> values)
+{
+    for (int k = 0; k < MeshData::attribCount; ++k) {
+        mesh.vertices[v * MeshData::attribCount + k] = values[k];
+    }
+}
+
+template <std::size_t V, std::size_t I>
+constexpr void setFixedColour(FixedMeshData<V, I>& mesh, std::size_t v, std::uint32_t seed)
+{
+    for (int c = 0; c < 3; ++c) {
+        mesh.vertices[v * MeshData::attribCount + 3 + c] = vertexRandom(seed, static_cast<std::uint32_t>(v), c);
+    }
+}
+
+template <int N>
+constexpr auto makeFixedCircle(float r, std::uint32_t seed)
+{
+    FixedMeshData<N + 1, 3 * N> mesh;
+    setFixedVertex(mesh, 0, { 0.0f, 0.0f, 0.0f,    0.0f, 1.0f, 0.0f,   0.5f, 0.5f,   0.0f, 0.0f, -1.0f });
+    for (int j = 0; j < N; ++j) {
+        const double c = constexprCos(j * 2.0 * std::numbers::pi / N);
+        const double s = constexprSin(j * 2.0 * std::numbers::pi / N);
+        setFixedVertex(mesh, j + 1, { float(r * c), float(r * s), 0.0f,    0.0f, 0.0f, 0.0f,
+            float(0.5 * c + 0.5), float(0.5 * s + 0.5),    0.0f, 0.0f, -1.0f });
+        setFixedColour(mesh, j + 1, seed);
+    }
+
+    for (int t = 0; t < N; ++t) {
+        mesh.indices[3 * t] = 0;
+        mesh.indices[3 * t + 1] = t + 1;
+        mesh.indices[3 * t + 2] = t + 2;
+    }
+    mesh.indices[3 * N - 1] = 1;
+    return mesh;
+}
+
+template <int N>
+constexpr auto makeFixedCone(float r, std::uint32_t seed)
+{
+    constexpr float h = 1.0f;
+    FixedMeshData<N + 2, 3 * N> mesh;
+    setFixedVertex(mesh, 0, { 0.0f, h, 0.0f,    0.0f, 1.0f, 0.0f,   0.5f, 0.5f,   0.0f, 0.0f, -1.0f });
+    for (int j = 0; j <= N; ++j) {
+        const double c = constexprCos((j % N) * 2.0 * std::numbers::pi / N);
+        const double s = constexprSin((j % N) * 2.0 * std::numbers::pi / N);
+        setFixedVertex(mesh, j + 1, { float(r * c), -h, float(r * s),    0.0f, 0.0f, 0.0f,
+            float(0.5 * c + 0.5), (-h / r + 1.0f) * 0.5f,    0.0f, 0.0f, -1.0f });
+        setFixedColour(mesh, j + 1, seed);
+    }
+
+    for (int t = 0; t < N; ++t) {
+        mesh.indices[3 * t] = 0;
+        mesh.indices[3 * t + 1] = t + 1;
+        mesh.indices[3 * t + 2] = t + 2;
+    }
+    mesh.indices[3 * N - 1] = 1;
+    return mesh;
+}
+
+template <int N>
+constexpr auto makeFixedCylinder(float r, std::uint32_t seed)
+{
+    constexpr float h = 1.0f;
+    constexpr unsigned int top = 2 * N + 1;
+    FixedMeshData<2 * (N + 1), 12 * N> mesh;
+
+    setFixedVertex(mesh, 0, { 0.0f, -h, 0.0f,    0.0f, 0.0f, 0.0f,   0.5f, 0.5f,   0.0f, 0.0f, -1.0f });
+    setFixedColour(mesh, 0, seed);
+    for (int j = 0; j < N; ++j) {
+        const double c = constexprCos(j * 2.0 * std::numbers::pi / N);
+        const double s = constexprSin(j * 2.0 * std::numbers::pi / N);
+        setFixedVertex(mesh, j + 1, { float(r * c), -h, float(r * s),    0.0f, 0.0f, 0.0f,
+            float(0.5 * c + 0.5), (-h / r + 1.0f) * 0.5f,    0.0f, 0.0f, -1.0f });
+        setFixedVertex(mesh, N + 1 + j, { float(r * c), h, float(r * s),    0.0f, 0.0f, 0.0f,
+            float(0.5 * c + 0.5), (h / r + 1.0f) * 0.5f,    0.0f, 0.0f, -1.0f });
+        setFixedColour(mesh, j + 1, seed);
+        setFixedColour(mesh, N + 1 + j, seed);
+    }
+    setFixedVertex(mesh, top, { 0.0f, h, 0.0f,    0.0f, 0.0f, 0.0f,   0.5f, 0.5f,   0.0f, 0.0f, -1.0f });
+
+    std::size_t k = 0;
+    for (unsigned int l = 1; l <= N; ++l, k += 3) { // bottom fan
+        mesh.indices[k] = 0;
+        mesh.indices[k + 1] = l;
+        mesh.indices[k + 2] = l < N ? l + 1 : 1;
+    }
+    for (unsigned int l = 1; l < N; ++l, k += 6) { // side
+        mesh.indices[k] = N + l;
+        mesh.indices[k + 1] = l;
+        mesh.indices[k + 2] = l + 1;
+
+        mesh.indices[k + 3] = l + 1;
+        mesh.indices[k + 4] = N + l + 1;
+        mesh.indices[k + 5] = N + l;
+    }
+    mesh.indices[k] = N + 1; // closing quad
+    mesh.indices[k + 1] = N;
+    mesh.indices[k + 2] = 1;
+
+    mesh.indices[k + 3] = 2 * N;
+    mesh.indices[k + 4] = N + 1;
+    mesh.indices[k + 5] = N;
+    k += 6;
+
+    for (unsigned int l = 1; l <= N; ++l, k += 3) { // top fan
+        mesh.indices[k] = top;
+        mesh.indices[k + 1] = N + l;
+        mesh.indices[k + 2] = l < N ? N + l + 1 : N + 1;
+    }
+    return mesh;
+}
+
+// Welded like SphereMesh: each pole is the first vertex of its ring, the rest of the ring and
+// the triangles that collapse onto the pole are left out, and vertices keep the colours of
+// their place in the unwelded grid.
+template <int N>
+constexpr auto makeFixedSphere(float r, std::uint32_t seed)
+{
+    constexpr int m = N;
+    constexpr unsigned int southPole = 1 + N * (m - 1);
+    FixedMeshData<N * (m - 1) + 2, 6 * N * (m - 1)> mesh;
+    auto welded = [](unsigned int i, unsigned int j) { return j == 0 ? 0 : j == m ? southPole : 1 + (j - 1) * N + i; };
+    for (int k = 0; k <= m; ++k) {
+        const double sinPolar = constexprSin(k * std::numbers::pi / m);
+        const double cosPolar = constexprCos(k * std::numbers::pi / m);
+        for (int j = 0; j < ((k == 0 || k == m) ? 1 : N); ++j) {
+            const double c = constexprCos(j * 2.0 * std::numbers::pi / N);
+            const double s = constexprSin(j * 2.0 * std::numbers::pi / N);
+            const std::size_t v = welded(j, k);
+            setFixedVertex(mesh, v, { float(r * c * sinPolar), float(r * s * sinPolar), float(r * cosPolar),    0.0f, 0.0f, 0.0f,
+                float(0.5 * c * sinPolar + 0.5), float(0.5 * s * sinPolar + 0.5),    float(c * sinPolar), float(s * sinPolar), float(cosPolar) });
+            for (int channel = 0; channel < 3; ++channel) {
+                mesh.vertices[v * MeshData::attribCount + 3 + channel] = vertexRandom(seed, static_cast<std::uint32_t>(k * N + j), channel);
+            }
+        }
+    }
+
+    std::size_t k = 0;
+    for (unsigned int j = 0; j < m; ++j) {
+        for (unsigned int i = 0; i < N; ++i) {
+            const unsigned int next = i + 1 < N ? i + 1 : 0;
+            if (j + 1 < m) {
+                mesh.indices[k++] = welded(i, j + 1);
+                mesh.indices[k++] = welded(i, j);
+                mesh.indices[k++] = welded(next, j + 1);
+            }
+            if (j > 0) {
+                mesh.indices[k++] = welded(i, j);
+                mesh.indices[k++] = welded(next, j);
+                mesh.indices[k++] = welded(next, j + 1);
+            }
+        }
+    }
+    return mesh;
+}
+
+template <int N>
+constexpr auto makeFixedTorus(float R, std::uint32_t seed)
+{
+    constexpr int m = N;
+    const float r = R / 2;
+    FixedMeshData<N * m, 6 * N * m> mesh;
+    for (int k = 0; k < m; ++k) {
+        const double sinSweep = constexprSin(k * 2.0 * std::numbers::pi / m);
+        const double cosSweep = constexprCos(k * 2.0 * std::numbers::pi / m);
+        for (int i = 0; i < N; ++i) {
+            const double cosTube = constexprCos(i * 2.0 * std::numbers::pi / N);
+            const double sinTube = constexprSin(i * 2.0 * std::numbers::pi / N);
+            const double radial = r * cosTube + R;
+            const std::size_t v = k * N + i;
+            setFixedVertex(mesh, v, { float(radial * sinSweep), float(radial * cosSweep), float(r * sinTube),
+                0.0f, 0.0f, 0.0f,    float(i) / N, float(k) / m,    float(cosTube * sinSweep), float(cosTube * cosSweep), float(sinTube) });
+            setFixedColour(mesh, v, seed);
+        }
+    }
+
+    std::size_t k = 0;
+    for (unsigned int j = 0; j < m; ++j) {
+        const unsigned int above = j + 1 < m ? j + 1 : 0; // the last row closes onto the first
+        for (unsigned int i = 0; i < N; ++i, k += 6) {
+            const unsigned int next = i + 1 < N ? i + 1 : 0;
+            mesh.indices[k] = i + above * N;
+            mesh.indices[k + 1] = i + j * N;
+            mesh.indices[k + 2] = next + above * N;
+
+            mesh.indices[k + 3] = i + j * N;
+            mesh.indices[k + 4] = next + j * N;
+            mesh.indices[k + 5] = next + above * N;
+        }
+    }
+    return mesh;
+}
+
+template <int N, float r = 1.0f, std::uint32_t seed = 0>
+inline constexpr auto fixedCircleData = makeFixedCircle<N>(r, seed);
+
+template <int N, float r = 1.0f, std::uint32_t seed = 0>
+inline constexpr auto fixedConeData = makeFixedCone<N>(r, seed);
+
+template <int N, float r = 0.8f, std::uint32_t seed = 0>
+inline constexpr auto fixedCylinderData = makeFixedCylinder<N>(r, seed);
+
+template <int N, float r = 1.0f, std::uint32_t seed = 0>
+inline constexpr auto fixedSphereData = makeFixedSphere<N>(r, seed);
+
+template <int N, float R = 0.5f, std::uint32_t seed = 0>
+inline constexpr auto fixedTorusData = makeFixedTorus<N>(R, seed);
+
+#endif // FIXEDSHAPES_H
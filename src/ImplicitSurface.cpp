@@ -0,0 +1,574 @@
+#include "ImplicitSurface.hpp"
+#include "ThreadPool.hpp"
+#include "VertexRandom.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+namespace {
+    constexpr int attribCount = MeshData::attribCount;
+
+    // A few field values side by side, so each primitive's distance is written once for
+    // every instruction set.
+#if defined(__AVX2__)
+    constexpr int lanes = 8;
+
+    struct Lanes
+    {
+        __m256 v;
+    };
+
+    Lanes splat(float x) { return { _mm256_set1_ps(x) }; }
+    Lanes load(const float* p) { return { _mm256_loadu_ps(p) }; }
+    void store(float* p, Lanes a) { _mm256_storeu_ps(p, a.v); }
+    Lanes operator+(Lanes a, Lanes b) { return { _mm256_add_ps(a.v, b.v) }; }
+    Lanes operator-(Lanes a, Lanes b) { return { _mm256_sub_ps(a.v, b.v) }; }
+    Lanes operator*(Lanes a, Lanes b) { return { _mm256_mul_ps(a.v, b.v) }; }
+    Lanes sqrt(Lanes a) { return { _mm256_sqrt_ps(a.v) }; }
+    Lanes min(Lanes a, Lanes b) { return { _mm256_min_ps(a.v, b.v) }; }
+    Lanes max(Lanes a, Lanes b) { return { _mm256_max_ps(a.v, b.v) }; }
+    Lanes abs(Lanes a) { return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v) }; }
+#elif defined(__SSE2__) || defined(_M_X64)
+    constexpr int lanes = 4;
+
+    struct Lanes
+    {
+        __m128 v;
+    };
+
+    Lanes splat(float x) { return { _mm_set1_ps(x) }; }
+    Lanes load(const float* p) { return { _mm_loadu_ps(p) }; }
+    void store(float* p, Lanes a) { _mm_storeu_ps(p, a.v); }
+    Lanes operator+(Lanes a, Lanes b) { return { _mm_add_ps(a.v, b.v) }; }
+    Lanes operator-(Lanes a, Lanes b) { return { _mm_sub_ps(a.v, b.v) }; }
+    Lanes operator*(Lanes a, Lanes b) { return { _mm_mul_ps(a.v, b.v) }; }
+    Lanes sqrt(Lanes a) { return { _mm_sqrt_ps(a.v) }; }
+    Lanes min(Lanes a, Lanes b) { return { _mm_min_ps(a.v, b.v) }; }
+    Lanes max(Lanes a, Lanes b) { return { _mm_max_ps(a.v, b.v) }; }
+    Lanes abs(Lanes a) { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+#else
+    constexpr int lanes = 4;
+
+    struct Lanes
+    {
+        std::array<float, lanes> v;
+    };
+
+    template <typename Op>
+    Lanes each(Lanes a, Lanes b, Op op)
+    {
+        Lanes out;
+        for (int l = 0; l < lanes; ++l) {
+            out.v[l] = op(a.v[l], b.v[l]);
+        }
+        return out;
+    }
+
+    Lanes splat(float x) { Lanes out; out.v.fill(x); return out; }
+    Lanes load(const float* p) { Lanes out; std::copy(p, p + lanes, out.v.begin()); return out; }
+    void store(float* p, Lanes a) { std::copy(a.v.begin(), a.v.end(), p); }
+    Lanes operator+(Lanes a, Lanes b) { return each(a, b, [](float x, float y) { return x + y; }); }
+    Lanes operator-(Lanes a, Lanes b) { return each(a, b, [](float x, float y) { return x - y; }); }
+    Lanes operator*(Lanes a, Lanes b) { return each(a, b, [](float x, float y) { return x * y; }); }
+    Lanes sqrt(Lanes a) { return each(a, a, [](float x, float) { return std::sqrt(x); }); }
+    Lanes min(Lanes a, Lanes b) { return each(a, b, [](float x, float y) { return std::min(x, y); }); }
+    Lanes max(Lanes a, Lanes b) { return each(a, b, [](float x, float y) { return std::max(x, y); }); }
+    Lanes abs(Lanes a) { return each(a, a, [](float x, float) { return std::abs(x); }); }
+#endif
+
+    // Polynomial smooth minimum. Its gradient is exactly mix(gradient b, gradient a, h).
+    float smoothUnion(float a, float b, float k, float& h)
+    {
+        if (k <= 0.0f) {
+            h = a < b ? 1.0f : 0.0f;
+            return std::min(a, b);
+        }
+        h = std::clamp(0.5f + 0.5f * (b - a) / k, 0.0f, 1.0f);
+        return b + h * (a - b) - k * h * (1.0f - h);
+    }
+
+    Lanes smoothUnion(Lanes a, Lanes b, float k)
+    {
+        if (k <= 0.0f) {
+            return min(a, b);
+        }
+        const Lanes h = min(max(splat(0.5f) + splat(0.5f / k) * (b - a), splat(0.0f)), splat(1.0f));
+        return b + h * (a - b) - splat(k) * h * (splat(1.0f) - h);
+    }
+
+    float length(float x, float y, float z)
+    {
+        return std::sqrt(x * x + y * y + z * z);
+    }
+
+    float primitiveDistance(const ImplicitPrimitive& p, float x, float y, float z, float gradient[3])
+    {
+        const float dx = x - p.centre[0];
+        const float dy = y - p.centre[1];
+        const float dz = z - p.centre[2];
+        switch (p.kind) {
+        case ImplicitKind::Sphere: {
+            const float l = length(dx, dy, dz);
+            const float inv = l > 0.0f ? 1.0f / l : 0.0f;
+            gradient[0] = dx * inv;
+            gradient[1] = dy * inv;
+            gradient[2] = l > 0.0f ? dz * inv : 1.0f;
+            return l - p.radius;
+        }
+        case ImplicitKind::Torus: {
+            const float ring = std::sqrt(dx * dx + dy * dy);
+            const float q = ring - p.size[0];
+            const float l = std::sqrt(q * q + dz * dz);
+            const float inv = l > 0.0f ? 1.0f / l : 0.0f;
+            const float radial = ring > 0.0f ? q * inv / ring : 0.0f;
+            gradient[0] = dx * radial;
+            gradient[1] = dy * radial;
+            gradient[2] = dz * inv;
+            return l - p.radius;
+        }
+        case ImplicitKind::Box: {
+            const float d[3] = { dx, dy, dz };
+            float q[3];
+            float outside = 0.0f;
+            int largest = 0;
+            for (int a = 0; a < 3; ++a) {
+                q[a] = std::abs(d[a]) - p.size[a] + p.radius;
+                outside += std::max(q[a], 0.0f) * std::max(q[a], 0.0f);
+                largest = q[a] > q[largest] ? a : largest;
+            }
+            outside = std::sqrt(outside);
+            for (int a = 0; a < 3; ++a) {
+                const float sign = d[a] < 0.0f ? -1.0f : 1.0f;
+                if (outside > 0.0f) {
+                    gradient[a] = sign * std::max(q[a], 0.0f) / outside;
+                }
+                else {
+                    gradient[a] = a == largest ? sign : 0.0f;
+                }
+            }
+            return outside + std::min(q[largest], 0.0f) - p.radius;
+        }
+        case ImplicitKind::Gyroid:
+        default: {
+            const float s = p.size[0];
+            const float sx = std::sin(s * dx), cx = std::cos(s * dx);
+            const float sy = std::sin(s * dy), cy = std::cos(s * dy);
+            const float sz = std::sin(s * dz), cz = std::cos(s * dz);
+            const float g = sx * cy + sy * cz + sz * cx;
+            const float sign = g < 0.0f ? -1.0f : 1.0f;
+            gradient[0] = sign * (cx * cy - sz * sx);
+            gradient[1] = sign * (cy * cz - sx * sy);
+            gradient[2] = sign * (cz * cx - sy * sz);
+            return std::abs(g) / s - p.radius;
+        }
+        }
+    }
+
+    // One primitive over lanes consecutive x samples of a row at (y, z). Gyroids read
+    // sin/cos of their x from tables filled once per grid.
+    Lanes primitiveLanes(const ImplicitPrimitive& p, Lanes x, float y, float z, const float* sinX, const float* cosX)
+    {
+        const Lanes dx = x - splat(p.centre[0]);
+        const float dy = y - p.centre[1];
+        const float dz = z - p.centre[2];
+        switch (p.kind) {
+        case ImplicitKind::Sphere:
+            return sqrt(dx * dx + splat(dy * dy + dz * dz)) - splat(p.radius);
+        case ImplicitKind::Torus: {
+            const Lanes q = sqrt(dx * dx + splat(dy * dy)) - splat(p.size[0]);
+            return sqrt(q * q + splat(dz * dz)) - splat(p.radius);
+        }
+        case ImplicitKind::Box: {
+            const Lanes zero = splat(0.0f);
+            const Lanes qx = abs(dx) - splat(p.size[0] - p.radius);
+            const float qy = std::abs(dy) - p.size[1] + p.radius;
+            const float qz = std::abs(dz) - p.size[2] + p.radius;
+            const Lanes mx = max(qx, zero);
+            const float my = std::max(qy, 0.0f);
+            const float mz = std::max(qz, 0.0f);
+            const Lanes outside = sqrt(mx * mx + splat(my * my + mz * mz));
+            const Lanes inside = min(max(qx, splat(std::max(qy, qz))), zero);
+            return outside + inside - splat(p.radius);
+        }
+        case ImplicitKind::Gyroid:
+        default: {
+            const float s = p.size[0];
+            const float sy = std::sin(s * dy), cy = std::cos(s * dy);
+            const float sz = std::sin(s * dz), cz = std::cos(s * dz);
+            const Lanes g = load(sinX) * splat(cy) + load(cosX) * splat(sz) + splat(sy * cz);
+            return abs(g) * splat(1.0f / s) - splat(p.radius);
+        }
+        }
+    }
+
+    // Cells are cubes; the grid covers the bounds, overhanging the short sides by less than a cell.
+    struct Grid
+    {
+        float origin[3];
+        float cell;
+        int cells[3];
+
+        std::size_t sample(int x, int y, int z) const
+        {
+            return (static_cast<std::size_t>(z) * (cells[1] + 1) + y) * (cells[0] + 1) + x;
+        }
+
+        std::size_t cellIndex(int x, int y, int z) const
+        {
+            return (static_cast<std::size_t>(z) * cells[1] + y) * cells[0] + x;
+        }
+    };
+
+    Grid makeGrid(const ImplicitSurfaceOptions& options)
+    {
+        float longest = 0.0f;
+        for (int a = 0; a < 3; ++a) {
+            longest = std::max(longest, options.boundsMax[a] - options.boundsMin[a]);
+        }
+        if (options.resolution < 1 || !(longest > 0.0f)) {
+            throw std::invalid_argument("Implicit surface needs non-empty bounds and a resolution of at least 1");
+        }
+
+        Grid grid;
+        grid.cell = longest / options.resolution;
+        for (int a = 0; a < 3; ++a) {
+            grid.origin[a] = options.boundsMin[a];
+            const float extent = options.boundsMax[a] - options.boundsMin[a];
+            grid.cells[a] = std::max(1, static_cast<int>(std::ceil(extent / grid.cell - 1e-4f)));
+        }
+        return grid;
+    }
+
+    unsigned threadCount(const ImplicitSurfaceOptions& options)
+    {
+        return options.threads == 0 ? std::thread::hardware_concurrency() : options.threads;
+    }
+
+    // Cell corner c is (c & 1, c >> 1 & 1, c >> 2 & 1); the 12 cell edges as corner pairs.
+    constexpr int cellEdges[12][2] = {
+        { 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 },
+        { 0, 2 }, { 1, 3 }, { 4, 6 }, { 5, 7 },
+        { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 },
+    };
+
+    // Whether the rows hold samples on both sides of the surface. Almost every row of a
+    // compact shape does not, and this loop vectorises where the per-cell work does not.
+    bool rowsStraddle(const float* const* rows, int count, int length)
+    {
+        int inside = 0;
+        for (int r = 0; r < count; ++r) {
+            for (int x = 0; x < length; ++x) {
+                inside += rows[r][x] < 0.0f;
+            }
+        }
+        return inside > 0 && inside < count * length;
+    }
+
+    struct Slab
+    {
+        std::vector<float> vertices; // without colours, filled in once the global index is known
+        std::vector<std::uint32_t> indices; // slab-local vertex indices are resolved when emitted
+    };
+
+    // Meshes sampled field values. valueAndGradient(x, y, z, gradient) gives the field and
+    // its gradient anywhere, for projecting vertices and for their normals.
+    template <typename ValueAndGradient>
+    MeshData polygonise(const Grid& grid, const std::vector<float>& samples, const ValueAndGradient& valueAndGradient,
+        const ImplicitSurfaceOptions& options, std::uint32_t seed)
+    {
+        const int nx = grid.cells[0];
+        const int ny = grid.cells[1];
+        const int nz = grid.cells[2];
+        const int depth = std::max(1, options.minPlanesPerSlab);
+        const int slabCount = (nz + depth - 1) / depth;
+        const unsigned threads = threadCount(options);
+
+        const std::size_t rowStride = nx + 1;
+        const std::size_t planeStride = rowStride * (ny + 1);
+
+        // only crossed cells are ever read back, so the map is left uninitialised
+        std::vector<Slab> slabs(slabCount);
+        std::unique_ptr<std::uint32_t[]> cellVertex(new std::uint32_t[static_cast<std::size_t>(nx) * ny * nz]);
+
+        // one vertex per crossed cell, numbered within its slab
+        ThreadPool::shared().parallelFor(slabCount, 1, threads, [&](std::size_t slabBegin, std::size_t slabEnd) {
+            for (std::size_t s = slabBegin; s < slabEnd; ++s) {
+                Slab& slab = slabs[s];
+                const int zEnd = std::min(nz, static_cast<int>(s + 1) * depth);
+                for (int z = static_cast<int>(s) * depth; z < zEnd; ++z) {
+                    for (int y = 0; y < ny; ++y) {
+                        // the four sample rows at the cell row's corners, in corner order
+                        const float* rows[4] = { &samples[grid.sample(0, y, z)], &samples[grid.sample(0, y + 1, z)],
+                            &samples[grid.sample(0, y, z + 1)], &samples[grid.sample(0, y + 1, z + 1)] };
+                        if (!rowsStraddle(rows, 4, nx + 1)) {
+                            continue;
+                        }
+                        for (int x = 0; x < nx; ++x) {
+                            float value[8];
+                            int inside = 0;
+                            for (int c = 0; c < 8; ++c) {
+                                value[c] = rows[c >> 1][x + (c & 1)];
+                                inside += value[c] < 0.0f;
+                            }
+                            if (inside == 0 || inside == 8) {
+                                continue;
+                            }
+
+                            float mean[3] = { 0.0f, 0.0f, 0.0f };
+                            int crossings = 0;
+                            for (const auto& edge : cellEdges) {
+                                const float v0 = value[edge[0]];
+                                const float v1 = value[edge[1]];
+                                if ((v0 < 0.0f) == (v1 < 0.0f)) {
+                                    continue;
+                                }
+                                const float t = v0 / (v0 - v1);
+                                for (int a = 0; a < 3; ++a) {
+                                    const float from = float(edge[0] >> a & 1);
+                                    mean[a] += from + t * (float(edge[1] >> a & 1) - from);
+                                }
+                                ++crossings;
+                            }
+
+                            const float low[3] = { grid.origin[0] + x * grid.cell, grid.origin[1] + y * grid.cell, grid.origin[2] + z * grid.cell };
+                            float position[3];
+                            for (int a = 0; a < 3; ++a) {
+                                position[a] = low[a] + mean[a] / crossings * grid.cell;
+                            }
+                            float gradient[3];
+                            if (options.projectToSurface) {
+                                const float f = valueAndGradient(position[0], position[1], position[2], gradient);
+                                const float squared = gradient[0] * gradient[0] + gradient[1] * gradient[1] + gradient[2] * gradient[2];
+                                if (squared > 1e-12f) {
+                                    for (int a = 0; a < 3; ++a) {
+                                        position[a] = std::clamp(position[a] - f * gradient[a] / squared, low[a], low[a] + grid.cell);
+                                    }
+                                }
+                            }
+                            valueAndGradient(position[0], position[1], position[2], gradient);
+                            const float l = length(gradient[0], gradient[1], gradient[2]);
+                            const float inv = l > 0.0f ? 1.0f / l : 0.0f;
+
+                            cellVertex[grid.cellIndex(x, y, z)] = static_cast<std::uint32_t>(slab.vertices.size() / attribCount);
+                            const float vertex[attribCount] = {
+                                position[0], position[1], position[2],
+                                0.0f, 0.0f, 0.0f,
+                                0.5f + 0.5f * gradient[0] * inv, 0.5f + 0.5f * gradient[1] * inv,
+                                gradient[0] * inv, gradient[1] * inv, gradient[2] * inv,
+                            };
+                            slab.vertices.insert(slab.vertices.end(), vertex, vertex + attribCount);
+                        }
+                    }
+                }
+            }
+        });
+
+        std::vector<std::uint32_t> firstVertex(slabCount + 1, 0);
+        for (int s = 0; s < slabCount; ++s) {
+            firstVertex[s + 1] = firstVertex[s] + static_cast<std::uint32_t>(slabs[s].vertices.size() / attribCount);
+        }
+        auto globalVertex = [&](int x, int y, int z) {
+            return cellVertex[grid.cellIndex(x, y, z)] + firstVertex[z / depth];
+        };
+
+        // a quad around every crossed edge between four cells, each edge belonging to the
+        // slab of its lower sample plane
+        ThreadPool::shared().parallelFor(slabCount, 1, threads, [&](std::size_t slabBegin, std::size_t slabEnd) {
+            for (std::size_t s = slabBegin; s < slabEnd; ++s) {
+                std::vector<std::uint32_t>& indices = slabs[s].indices;
+                const int zEnd = std::min(nz, static_cast<int>(s + 1) * depth);
+                for (int z = static_cast<int>(s) * depth; z < zEnd; ++z) {
+                    for (int y = 0; y < ny; ++y) {
+                        const float* rows[3] = { &samples[grid.sample(0, y, z)], &samples[grid.sample(0, y + 1, z)],
+                            &samples[grid.sample(0, y, z + 1)] };
+                        if (!rowsStraddle(rows, 3, nx + 1)) {
+                            continue; // no edge from this row crosses
+                        }
+                        for (int x = 0; x < nx; ++x) {
+                            const std::size_t sample = grid.sample(x, y, z);
+                            const bool inside = samples[sample] < 0.0f;
+                            const std::size_t neighbour[3] = { sample + 1, sample + rowStride, sample + planeStride };
+                            const int p[3] = { x, y, z };
+                            for (int a = 0; a < 3; ++a) {
+                                const int b = (a + 1) % 3;
+                                const int c = (a + 2) % 3;
+                                if ((samples[neighbour[a]] < 0.0f) == inside || p[b] == 0 || p[c] == 0) {
+                                    continue; // not crossed, or short of cells on all four sides
+                                }
+
+                                // the cells around the edge, counter-clockwise about +a
+                                std::uint32_t around[4];
+                                constexpr int offsets[4][2] = { { -1, -1 }, { 0, -1 }, { 0, 0 }, { -1, 0 } };
+                                for (int k = 0; k < 4; ++k) {
+                                    int cell[3] = { x, y, z };
+                                    cell[b] += offsets[k][0];
+                                    cell[c] += offsets[k][1];
+                                    around[k] = globalVertex(cell[0], cell[1], cell[2]);
+                                }
+                                if (!inside) {
+                                    std::swap(around[1], around[3]); // the surface faces -a
+                                }
+                                indices.insert(indices.end(), { around[0], around[1], around[2], around[0], around[2], around[3] });
+                            }
+                        }
+                    }
+                }
+            }
+        });
+
+        MeshData mesh;
+        std::vector<std::size_t> firstIndex(slabCount + 1, 0);
+        for (int s = 0; s < slabCount; ++s) {
+            firstIndex[s + 1] = firstIndex[s] + slabs[s].indices.size();
+        }
+        mesh.vertices.resize(static_cast<std::size_t>(firstVertex[slabCount]) * attribCount);
+        mesh.indices.resize(firstIndex[slabCount]);
+        ThreadPool::shared().parallelFor(slabCount, 1, threads, [&](std::size_t slabBegin, std::size_t slabEnd) {
+            for (std::size_t s = slabBegin; s < slabEnd; ++s) {
+                const Slab& slab = slabs[s];
+                float* out = &mesh.vertices[static_cast<std::size_t>(firstVertex[s]) * attribCount];
+                std::copy(slab.vertices.begin(), slab.vertices.end(), out);
+                for (std::uint32_t v = firstVertex[s]; v < firstVertex[s + 1]; ++v, out += attribCount) {
+                    out[3] = vertexRandom(seed, v, 0);
+                    out[4] = vertexRandom(seed, v, 1);
+                    out[5] = vertexRandom(seed, v, 2);
+                }
+                std::copy(slab.indices.begin(), slab.indices.end(), mesh.indices.begin() + firstIndex[s]);
+            }
+        });
+        return mesh;
+    }
+}
+
+ImplicitPrimitive implicitSphere(float x, float y, float z, float r)
+{
+    return { ImplicitKind::Sphere, { x, y, z }, r };
+}
+
+ImplicitPrimitive implicitTorus(float x, float y, float z, float R, float r)
+{
+    return { ImplicitKind::Torus, { x, y, z }, r, { R, 0.0f, 0.0f } };
+}
+
+ImplicitPrimitive implicitBox(float x, float y, float z, float halfWidth, float halfHeight, float halfDepth, float rounding)
+{
+    return { ImplicitKind::Box, { x, y, z }, rounding, { halfWidth, halfHeight, halfDepth } };
+}
+
+ImplicitPrimitive implicitGyroid(float frequency, float thickness)
+{
+    return { ImplicitKind::Gyroid, { 0.0f, 0.0f, 0.0f }, thickness, { frequency, 0.0f, 0.0f } };
+}
+
+float ImplicitField::evaluate(float x, float y, float z) const
+{
+    float gradient[3];
+    return evaluate(x, y, z, gradient);
+}
+
+float ImplicitField::evaluate(float x, float y, float z, float gradient[3]) const
+{
+    if (primitives.empty()) {
+        gradient[0] = gradient[1] = gradient[2] = 0.0f;
+        return std::numeric_limits<float>::max();
+    }
+    float d = primitiveDistance(primitives[0], x, y, z, gradient);
+    for (std::size_t i = 1; i < primitives.size(); ++i) {
+        float g[3];
+        const float next = primitiveDistance(primitives[i], x, y, z, g);
+        float h;
+        d = smoothUnion(d, next, blend, h);
+        for (int a = 0; a < 3; ++a) {
+            gradient[a] = g[a] + h * (gradient[a] - g[a]);
+        }
+    }
+    return d;
+}
+
+MeshData generateImplicitSurface(const ImplicitField& field, const ImplicitSurfaceOptions& options, std::uint32_t seed)
+{
+    const Grid grid = makeGrid(options);
+    const int rowLength = grid.cells[0] + 1;
+    const int paddedLength = (rowLength + lanes - 1) / lanes * lanes;
+
+    // x is the same along every row, so it and the gyroids' sin/cos of it are tabled once
+    std::vector<float> xs(paddedLength);
+    for (int x = 0; x < paddedLength; ++x) {
+        xs[x] = grid.origin[0] + x * grid.cell;
+    }
+    std::vector<std::vector<float>> sinX(field.primitives.size());
+    std::vector<std::vector<float>> cosX(field.primitives.size());
+    for (std::size_t i = 0; i < field.primitives.size(); ++i) {
+        const ImplicitPrimitive& p = field.primitives[i];
+        if (p.kind != ImplicitKind::Gyroid) {
+            continue;
+        }
+        sinX[i].resize(paddedLength);
+        cosX[i].resize(paddedLength);
+        for (int x = 0; x < paddedLength; ++x) {
+            sinX[i][x] = std::sin(p.size[0] * (xs[x] - p.centre[0]));
+            cosX[i][x] = std::cos(p.size[0] * (xs[x] - p.centre[0]));
+        }
+    }
+
+    std::vector<float> samples(static_cast<std::size_t>(grid.cells[2] + 1) * (grid.cells[1] + 1) * rowLength);
+    ThreadPool::shared().parallelFor(grid.cells[2] + 1, std::max(1, options.minPlanesPerSlab), threadCount(options),
+        [&](std::size_t zBegin, std::size_t zEnd) {
+            std::vector<float> row(paddedLength);
+            for (std::size_t z = zBegin; z < zEnd; ++z) {
+                const float pz = grid.origin[2] + z * grid.cell;
+                for (int y = 0; y <= grid.cells[1]; ++y) {
+                    const float py = grid.origin[1] + y * grid.cell;
+                    for (int x = 0; x < paddedLength; x += lanes) {
+                        Lanes d = splat(std::numeric_limits<float>::max());
+                        for (std::size_t i = 0; i < field.primitives.size(); ++i) {
+                            const Lanes next = primitiveLanes(field.primitives[i], load(&xs[x]), py, pz,
+                                sinX[i].empty() ? nullptr : &sinX[i][x], cosX[i].empty() ? nullptr : &cosX[i][x]);
+                            d = i == 0 ? next : smoothUnion(d, next, field.blend);
+                        }
+                        store(&row[x], d);
+                    }
+                    std::copy(row.begin(), row.begin() + rowLength, samples.begin() + grid.sample(0, y, static_cast<int>(z)));
+                }
+            }
+        });
+
+    return polygonise(grid, samples, [&](float x, float y, float z, float gradient[3]) {
+        return field.evaluate(x, y, z, gradient);
+    }, options, seed);
+}
+
+MeshData generateImplicitSurface(const ScalarField& field, const ImplicitSurfaceOptions& options, std::uint32_t seed)
+{
+    const Grid grid = makeGrid(options);
+    std::vector<float> samples(static_cast<std::size_t>(grid.cells[2] + 1) * (grid.cells[1] + 1) * (grid.cells[0] + 1));
+    ThreadPool::shared().parallelFor(grid.cells[2] + 1, std::max(1, options.minPlanesPerSlab), threadCount(options),
+        [&](std::size_t zBegin, std::size_t zEnd) {
+            for (std::size_t z = zBegin; z < zEnd; ++z) {
+                for (int y = 0; y <= grid.cells[1]; ++y) {
+                    for (int x = 0; x <= grid.cells[0]; ++x) {
+                        samples[grid.sample(x, y, static_cast<int>(z))] = field(grid.origin[0] + x * grid.cell,
+                            grid.origin[1] + y * grid.cell, grid.origin[2] + z * grid.cell);
+                    }
+                }
+            }
+        });
+
+    const float h = 0.01f * grid.cell;
+    return polygonise(grid, samples, [&](float x, float y, float z, float gradient[3]) {
+        gradient[0] = (field(x + h, y, z) - field(x - h, y, z)) / (2.0f * h);
+        gradient[1] = (field(x, y + h, z) - field(x, y - h, z)) / (2.0f * h);
+        gradient[2] = (field(x, y, z + h) - field(x, y, z - h)) / (2.0f * h);
+        return field(x, y, z);
+    }, options, seed);
+}
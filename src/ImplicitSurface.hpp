@@ -0,0 +1,76 @@
+#ifndef IMPLICITSURFACE_H
+#define IMPLICITSURFACE_H
+
+#include "MeshData.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Shapes given as the zero set of a scalar field, negative inside, polygonised on a grid
+// of cubic cells. The built-in fields are signed distances (or close to them) so they can
+// be blended; any other field can be passed as a ScalarField.
+
+enum class ImplicitKind : std::uint32_t
+{
+    Sphere,  // radius
+    Torus,   // around the z axis like generateTorus: sweep radius size[0], tube radius
+    Box,     // half extents size, corners rounded by radius
+    Gyroid,  // sin x cos y + sin y cos z + sin z cos x at frequency size[0], a sheet radius thick on either side
+};
+
+struct ImplicitPrimitive
+{
+    ImplicitKind kind{ ImplicitKind::Sphere };
+    float centre[3]{ 0.0f, 0.0f, 0.0f };
+    float radius{ 1.0f };
+    float size[3]{ 0.0f, 0.0f, 0.0f };
+};
+
+ImplicitPrimitive implicitSphere(float x, float y, float z, float r);
+ImplicitPrimitive implicitTorus(float x, float y, float z, float R, float r);
+ImplicitPrimitive implicitBox(float x, float y, float z, float halfWidth, float halfHeight, float halfDepth, float rounding = 0.0f);
+ImplicitPrimitive implicitGyroid(float frequency, float thickness);
+
+// The union of the primitives, smoothed over blend units where they meet: spheres with a
+// blend are metaballs. blend 0 is the plain union.
+struct ImplicitField
+{
+    std::vector<ImplicitPrimitive> primitives;
+    float blend{ 0.0f };
+
+    float evaluate(float x, float y, float z) const;
+    float evaluate(float x, float y, float z, float gradient[3]) const; // with the analytic gradient
+};
+
+using ScalarField = std::function<float(float x, float y, float z)>;
+
+// The region to polygonise and how finely. Cells are cubes, resolution of them along the
+// longest side of the bounds; a surface that leaves the bounds is cut open there.
+//  projectToSurface: moves each vertex one Newton step onto the surface (within its cell)
+//  threads: the grid is cut into slabs of z planes that are sampled and meshed in parallel
+struct ImplicitSurfaceOptions
+{
+    float boundsMin[3]{ -1.5f, -1.5f, -1.5f };
+    float boundsMax[3]{ 1.5f, 1.5f, 1.5f };
+    int resolution{ 64 };
+    bool projectToSurface{ true };
+    unsigned threads{ 1 };                      // 1 == serial, 0 == one per hardware thread
+    int minPlanesPerSlab{ 4 };
+};
+
+// Surface nets: one vertex in every cell the surface crosses, at the mean of the crossings
+// on the cell's edges, and a quad around every crossed edge. Neighbouring cells share their
+// vertices, so the mesh is indexed with no duplicates and is closed wherever the surface
+// stays inside the bounds. Triangles wind counter-clockwise seen from outside; normals are
+// the normalised gradient and colours are seeded per vertex. Output is the same whatever
+// the thread count.
+//
+// Built-in fields are sampled a row of x at a time with AVX2/SSE2 when the build enables
+// them, and their normals are analytic.
+MeshData generateImplicitSurface(const ImplicitField& field, const ImplicitSurfaceOptions& options = {}, std::uint32_t seed = 0);
+
+// Any field, sampled point by point; normals by central differences.
+MeshData generateImplicitSurface(const ScalarField& field, const ImplicitSurfaceOptions& options = {}, std::uint32_t seed = 0);
+
+#endif // IMPLICITSURFACE_H
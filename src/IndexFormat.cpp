@@ -0,0 +1,64 @@
+#include "IndexFormat.hpp"
+#include "MeshData.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace {
+    template<typename T>
+    void narrow(std::span<const std::uint32_t> indices, std::byte* out)
+    {
+        for (std::uint32_t index : indices) {
+            const T value = index == MeshData::restartIndex ? std::numeric_limits<T>::max() : static_cast<T>(index);
+            std::memcpy(out, &value, sizeof(T));
+            out += sizeof(T);
+        }
+    }
+}
+
+std::size_t indexSize(IndexType type)
+{
+    switch (type) {
+    case IndexType::U8: return 1;
+    case IndexType::U16: return 2;
+    default: return 4;
+    }
+}
+
+std::uint32_t restartIndex(IndexType type)
+{
+    switch (type) {
+    case IndexType::U8: return std::numeric_limits<std::uint8_t>::max();
+    case IndexType::U16: return std::numeric_limits<std::uint16_t>::max();
+    default: return std::numeric_limits<std::uint32_t>::max();
+    }
+}
+
+IndexType smallestIndexType(std::span<const std::uint32_t> indices, bool allowU8)
+{
+    std::uint32_t largest = 0;
+    for (std::uint32_t index : indices) {
+        if (index != MeshData::restartIndex) {
+            largest = std::max(largest, index);
+        }
+    }
+    if (allowU8 && largest < restartIndex(IndexType::U8)) {
+        return IndexType::U8;
+    }
+    if (largest < restartIndex(IndexType::U16)) {
+        return IndexType::U16;
+    }
+    return IndexType::U32;
+}
+
+std::vector<std::byte> packIndices(std::span<const std::uint32_t> indices, IndexType type)
+{
+    std::vector<std::byte> packed(indices.size() * indexSize(type));
+    switch (type) {
+    case IndexType::U8: narrow<std::uint8_t>(indices, packed.data()); break;
+    case IndexType::U16: narrow<std::uint16_t>(indices, packed.data()); break;
+    case IndexType::U32: std::memcpy(packed.data(), indices.data(), indices.size_bytes()); break;
+    }
+    return packed;
+}
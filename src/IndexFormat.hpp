@@ -0,0 +1,31 @@
+#ifndef INDEXFORMAT_H
+#define INDEXFORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Width of the indices in an uploaded element buffer. Generators always produce
+// 32-bit indices; they are narrowed at upload time.
+enum class IndexType
+{
+    U8,
+    U16,
+    U32,
+};
+
+std::size_t indexSize(IndexType type); // bytes per index
+
+// The largest value of the type, which is reserved as the primitive restart index.
+std::uint32_t restartIndex(IndexType type);
+
+// Smallest type that can hold every index below its restart index (MeshData::restartIndex
+// entries are ignored). U8 is only picked when allowed: many drivers convert byte
+// indices on upload or in the vertex fetch.
+IndexType smallestIndexType(std::span<const std::uint32_t> indices, bool allowU8 = false);
+
+// Narrows the indices; restart indices become the restart index of the new type.
+std::vector<std::byte> packIndices(std::span<const std::uint32_t> indices, IndexType type);
+
+#endif // INDEXFORMAT_H
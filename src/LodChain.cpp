@@ -0,0 +1,189 @@
+#include "LodChain.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+namespace {
+    constexpr int attribCount = MeshData::attribCount;
+
+    std::vector<int> levelResolutions(int n, int minN, int maxLevels)
+    {
+        std::vector<int> resolutions;
+        for (int level = n; level >= minN && static_cast<int>(resolutions.size()) < maxLevels; level /= 2) {
+            resolutions.push_back(level);
+        }
+        if (resolutions.empty()) {
+            resolutions.push_back(n);
+        }
+        return resolutions;
+    }
+
+    // Centre of the bounds and the radius around it that holds every vertex.
+    void fitBoundingSphere(LodChain& chain)
+    {
+        std::array<float, 3> low, high;
+        low.fill(std::numeric_limits<float>::max());
+        high.fill(std::numeric_limits<float>::lowest());
+        for (std::size_t v = 0; v < chain.mesh.vertexCount(); ++v) {
+            for (int c = 0; c < 3; ++c) {
+                low[c] = std::min(low[c], chain.mesh.vertices[v * attribCount + c]);
+                high[c] = std::max(high[c], chain.mesh.vertices[v * attribCount + c]);
+            }
+        }
+        for (int c = 0; c < 3; ++c) {
+            chain.centre[c] = chain.mesh.vertices.empty() ? 0.0f : 0.5f * (low[c] + high[c]);
+        }
+        chain.radius = 0.0f;
+        for (std::size_t v = 0; v < chain.mesh.vertexCount(); ++v) {
+            float distance = 0.0f;
+            for (int c = 0; c < 3; ++c) {
+                const float d = chain.mesh.vertices[v * attribCount + c] - chain.centre[c];
+                distance += d * d;
+            }
+            chain.radius = std::max(chain.radius, std::sqrt(distance));
+        }
+    }
+
+    // Morph targets for one columns x rows grid level starting at vertex first.
+    void gridMorphTargets(LodChain& chain, std::size_t first, int columns, int rows, bool closedRows)
+    {
+        const float* vertices = &chain.mesh.vertices[first * attribCount];
+        float* targets = &chain.morphTargets[first * 3];
+        auto position = [&](int i, int j) {
+            i = (i + columns) % columns;
+            if (closedRows) {
+                j = (j + rows) % rows;
+            }
+            return &vertices[(static_cast<std::size_t>(j) * columns + i) * attribCount];
+        };
+
+        for (int j = 0; j < rows; ++j) {
+            for (int i = 0; i < columns; ++i) {
+                // odd columns/rows lie halfway along a coarse edge: horizontal, vertical or the diagonal
+                const bool oddI = i % 2 != 0;
+                const bool oddJ = j % 2 != 0 && (closedRows || j + 1 < rows);
+                const float* a = position(oddI ? i - 1 : i, oddJ ? j - 1 : j);
+                const float* b = position(oddI ? i + 1 : i, oddJ ? j + 1 : j);
+                float* target = &targets[(static_cast<std::size_t>(j) * columns + i) * 3];
+                for (int c = 0; c < 3; ++c) {
+                    target[c] = 0.5f * (a[c] + b[c]);
+                }
+            }
+        }
+    }
+}
+
+LodChain buildLodChain(const std::function<MeshData(int)>& generate, int n, int minN, int maxLevels)
+{
+    LodChain chain;
+    const std::vector<int> resolutions = levelResolutions(n, minN, maxLevels);
+
+    for (int resolution : resolutions) {
+        MeshData level = generate(resolution);
+        if (chain.levels.empty()) {
+            chain.mesh.primitive = level.primitive;
+        }
+        const unsigned int base = static_cast<unsigned int>(chain.mesh.vertexCount());
+        chain.levels.push_back({ chain.mesh.indices.size(), level.indices.size(), 0.0f });
+        for (unsigned int index : level.indices) {
+            chain.mesh.indices.push_back(index == MeshData::restartIndex ? index : index + base);
+        }
+        chain.mesh.vertices.insert(chain.mesh.vertices.end(), level.vertices.begin(), level.vertices.end());
+    }
+
+    fitBoundingSphere(chain);
+    for (std::size_t level = 0; level < chain.levels.size(); ++level) {
+        chain.levels[level].error = chain.radius * (1.0f - std::cos(std::numbers::pi_v<float> / resolutions[level]));
+    }
+    return chain;
+}
+
+LodChain buildGridLodChain(const std::function<MeshData(int)>& generate, int n, bool closedRows, int minN, int maxLevels)
+{
+    LodChain chain = buildLodChain(generate, n, minN, maxLevels);
+    const std::vector<int> resolutions = levelResolutions(n, minN, maxLevels);
+
+    // Every vertex starts out as its own target; the grid levels are then filled in.
+    chain.morphTargets.resize(chain.mesh.vertexCount() * 3);
+    for (std::size_t v = 0; v < chain.mesh.vertexCount(); ++v) {
+        for (int c = 0; c < 3; ++c) {
+            chain.morphTargets[v * 3 + c] = chain.mesh.vertices[v * attribCount + c];
+        }
+    }
+
+    std::size_t first = 0;
+    for (std::size_t level = 0; level < resolutions.size(); ++level) {
+        const int columns = resolutions[level];
+        const int rows = closedRows ? columns : columns + 1;
+        if (level + 1 < resolutions.size() && columns % 2 == 0) {
+            gridMorphTargets(chain, first, columns, rows, closedRows);
+        }
+        first += static_cast<std::size_t>(columns) * rows;
+    }
+    return chain;
+}
+
+LodChain buildSimplifiedLodChain(MeshData mesh, int maxLevels, const SimplifyOptions& options)
+{
+    LodChain chain;
+    chain.mesh = std::move(mesh);
+    chain.levels.push_back({ 0, chain.mesh.indices.size(), 0.0f });
+    fitBoundingSphere(chain);
+    if (chain.mesh.primitive != Primitive::Triangles) {
+        return chain;
+    }
+
+    // Each level simplifies the one before it, so the errors add up.
+    std::vector<unsigned int> level(chain.mesh.indices);
+    while (static_cast<int>(chain.levels.size()) < maxLevels) {
+        const float error = chain.levels.back().error;
+        SimplifyOptions halve = options;
+        halve.targetTriangles = level.size() / 6;
+        halve.maxError = options.maxError - error;
+        if (halve.maxError <= 0.0f) {
+            break;
+        }
+        SimplifyResult coarser = simplifyIndices(chain.mesh.vertices, level, halve);
+        if (coarser.indices.empty() || coarser.indices.size() * 4 > level.size() * 3) {
+            break; // locked or within the error bound: not worth a level
+        }
+        level = std::move(coarser.indices);
+        chain.levels.push_back({ chain.mesh.indices.size(), level.size(), error + coarser.error });
+        chain.mesh.indices.insert(chain.mesh.indices.end(), level.begin(), level.end());
+    }
+    return chain;
+}
+
+int selectLod(std::span<const LodLevel> levels, float pixelsPerUnit, int current, float thresholdPixels, float hysteresis)
+{
+    if (levels.empty()) {
+        return 0;
+    }
+    current = std::clamp(current, 0, static_cast<int>(levels.size()) - 1);
+
+    auto coarsestWithin = [&](float pixels) {
+        int level = 0;
+        for (int candidate = 0; candidate < static_cast<int>(levels.size()); ++candidate) {
+            if (levels[candidate].error * pixelsPerUnit <= pixels) {
+                level = candidate;
+            }
+        }
+        return level;
+    };
+
+    if (levels[current].error * pixelsPerUnit > thresholdPixels) {
+        return coarsestWithin(thresholdPixels); // too coarse: refine straight away
+    }
+    return std::max(current, coarsestWithin(thresholdPixels * (1.0f - hysteresis)));
+}
+
+float lodMorphFactor(std::span<const LodLevel> levels, int level, float pixelsPerUnit, float thresholdPixels)
+{
+    if (level < 0 || level + 1 >= static_cast<int>(levels.size()) || thresholdPixels <= 0.0f) {
+        return 0.0f;
+    }
+    const float coarserPixels = levels[level + 1].error * pixelsPerUnit;
+    return std::clamp((2.0f * thresholdPixels - coarserPixels) / thresholdPixels, 0.0f, 1.0f);
+}
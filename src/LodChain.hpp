@@ -0,0 +1,64 @@
+#ifndef LODCHAIN_H
+#define LODCHAIN_H
+
+#include "MeshData.hpp"
+#include "MeshSimplifier.hpp"
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <vector>
+
+// One level of detail inside a LodChain's shared buffers.
+//  error: object-space geometric error of the level (how far it can stray from the true surface)
+struct LodLevel
+{
+    std::size_t firstIndex{ 0 };
+    std::size_t indexCount{ 0 };
+    float error{ 0.0f };
+};
+
+// All levels of a shape in one vertex and one index buffer, finest first. Level indices are
+// already offset to their vertices, so each level is a plain range of the index buffer.
+struct LodChain
+{
+    MeshData mesh;
+    std::vector<LodLevel> levels;
+    std::vector<float> morphTargets; // geomorphing only: 3 floats per vertex, where it sits on the next coarser level
+    std::array<float, 3> centre{ 0.0f, 0.0f, 0.0f };
+    float radius{ 0.0f }; // bounding sphere around centre
+};
+
+// Generates generate(n), generate(n / 2), ... down to minN or maxLevels levels. Each level's
+// error is the sagitta of one of its n segments on the bounding sphere, radius * (1 - cos(pi / n)),
+// which bounds the error of the revolved shapes (circle, cone, cylinder, sphere, tori).
+LodChain buildLodChain(const std::function<MeshData(int)>& generate, int n, int minN = 8, int maxLevels = 6);
+
+// As buildLodChain, for shapes whose vertices form a grid of n columns (wrapping around) by
+// n rows, plus one when the rows do not wrap (sphere: false, tori: true), indexed with the
+// (i, j)-(i+1, j+1) diagonal. Halving n keeps every even vertex in place, so each vertex's
+// morph target is its position interpolated linearly over the coarser level's triangles.
+// Levels whose n is odd, and the coarsest level, morph onto themselves.
+LodChain buildGridLodChain(const std::function<MeshData(int)>& generate, int n, bool closedRows, int minN = 8, int maxLevels = 6);
+
+// For meshes that cannot be generated again at a lower n (imported or merged geometry): level
+// 0 is the mesh as given, and each further level is the one before simplified to half as many
+// triangles (see simplifyIndices), all indexing the one vertex buffer. options supplies the
+// weights and threads; the chain ends at maxLevels, once a level's error would pass
+// options.maxError, or when simplification stalls.
+LodChain buildSimplifiedLodChain(MeshData mesh, int maxLevels = 6, const SimplifyOptions& options = {});
+
+// Picks the coarsest level whose error projects to at most thresholdPixels, given how many
+// pixels one object-space unit covers at the object's distance. Moving to a coarser level
+// additionally needs the error to be hysteresis (as a fraction) under the threshold, so a
+// shape sitting at a boundary does not flicker between levels.
+int selectLod(std::span<const LodLevel> levels, float pixelsPerUnit, int current,
+    float thresholdPixels = 1.0f, float hysteresis = 0.25f);
+
+// How far a geomorphing level has blended towards its morph targets. Select the level with
+// no hysteresis: the factor reaches 1 exactly where the coarser level takes over, and falls
+// to 0 once the coarser level's error projects to twice the threshold.
+float lodMorphFactor(std::span<const LodLevel> levels, int level, float pixelsPerUnit, float thresholdPixels = 1.0f);
+
+#endif // LODCHAIN_H
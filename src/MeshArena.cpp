@@ -0,0 +1,194 @@
+#include "MeshArena.hpp"
+#include "ShapeMesh.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+MeshArena::MeshArena(VertexLayout vertexLayout, IndexType indexType)
+    : m_layout(vertexLayout)
+    , m_indexType(indexType)
+{
+    if (vertexLayout == VertexLayout::SplitPosition || vertexLayout == VertexLayout::Planar) {
+        throw std::invalid_argument("MeshArena: the vertex layout must be Interleaved or Quantized");
+    }
+    m_vbo = std::make_unique<VBO>();
+    m_ebo = std::make_unique<EBO>();
+    m_vao.bind();
+    m_vbo->bind();
+    m_ebo->bind();
+    pointAttributes();
+    for (GLuint location = 0; location < 4; ++location) {
+        glEnableVertexAttribArray(location);
+    }
+    m_vao.unBind();
+    m_vbo->unBind();
+    m_ebo->unBind();
+}
+
+ArenaMesh MeshArena::add(const MeshData& data)
+{
+    const std::size_t vertexCount = data.vertexCount();
+    const std::size_t indexCount = data.indices.size();
+    if (indexCount > 0 && vertexCount > restartIndex(m_indexType)) {
+        throw std::invalid_argument("MeshArena: the mesh has more vertices than the index type can address");
+    }
+
+    PackedVertices packed;
+    std::span<const std::byte> vertexBytes = std::as_bytes(std::span(data.vertices));
+    if (m_layout != VertexLayout::Interleaved) {
+        packed = packVertices(data.vertices, m_layout);
+        vertexBytes = packed.bytes;
+    }
+    std::vector<std::byte> packedIndices;
+    std::span<const std::byte> indexBytes = std::as_bytes(std::span(data.indices));
+    if (m_indexType != IndexType::U32) {
+        packedIndices = packIndices(data.indices, m_indexType);
+        indexBytes = packedIndices;
+    }
+
+    const std::size_t vertexCapacity = m_vertexCount + vertexCount > m_vertexCapacity
+        ? std::max(m_vertexCount + vertexCount, 2 * m_vertexCapacity) : m_vertexCapacity;
+    const std::size_t indexCapacity = m_indexCount + indexCount > m_indexCapacity
+        ? std::max(m_indexCount + indexCount, 2 * m_indexCapacity) : m_indexCapacity;
+    grow(vertexCapacity, indexCapacity);
+
+    // Written through the copy targets so that no VAO's element buffer binding changes
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_vbo->id());
+    glBufferSubData(GL_COPY_WRITE_BUFFER, m_vertexCount * vertexSize(m_layout), vertexBytes.size_bytes(), vertexBytes.data());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_ebo->id());
+    glBufferSubData(GL_COPY_WRITE_BUFFER, m_indexCount * indexSize(m_indexType), indexBytes.size_bytes(), indexBytes.data());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    ArenaMesh mesh;
+    mesh.firstIndex = m_indexCount;
+    mesh.indexCount = static_cast<GLsizei>(indexCount);
+    mesh.baseVertex = static_cast<GLint>(m_vertexCount);
+    mesh.vertexCount = static_cast<GLsizei>(vertexCount);
+    mesh.primitive = toGLPrimitive(data.primitive);
+    mesh.dequantization = packed.dequantization;
+    m_vertexCount += vertexCount;
+    m_indexCount += indexCount;
+    return mesh;
+}
+
+void MeshArena::reserve(std::size_t vertexCount, std::size_t indexCount)
+{
+    grow(std::max(vertexCount, m_vertexCapacity), std::max(indexCount, m_indexCapacity));
+}
+
+void MeshArena::clear()
+{
+    m_vertexCount = 0;
+    m_indexCount = 0;
+}
+
+std::size_t MeshArena::vertexCount() const
+{
+    return m_vertexCount;
+}
+
+std::size_t MeshArena::indexCount() const
+{
+    return m_indexCount;
+}
+
+VertexLayout MeshArena::layout() const
+{
+    return m_layout;
+}
+
+// Moves whichever buffer is too small into a new one of the given capacity. The VAO keeps
+// the old vertex buffer until the attributes are pointed again.
+void MeshArena::grow(std::size_t vertexCapacity, std::size_t indexCapacity)
+{
+    if (vertexCapacity <= m_vertexCapacity && indexCapacity <= m_indexCapacity) {
+        return;
+    }
+    m_vao.bind();
+    if (vertexCapacity > m_vertexCapacity) {
+        const std::size_t stride = vertexSize(m_layout);
+        auto vbo = std::make_unique<VBO>();
+        vbo->bind();
+        glBufferData(GL_ARRAY_BUFFER, vertexCapacity * stride, nullptr, GL_STATIC_DRAW);
+        if (m_vertexCount > 0) {
+            glBindBuffer(GL_COPY_READ_BUFFER, m_vbo->id());
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_ARRAY_BUFFER, 0, 0, m_vertexCount * stride);
+        }
+        m_vbo = std::move(vbo);
+        pointAttributes();
+        m_vertexCapacity = vertexCapacity;
+    }
+    if (indexCapacity > m_indexCapacity) {
+        const std::size_t size = indexSize(m_indexType);
+        auto ebo = std::make_unique<EBO>();
+        ebo->bind();
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCapacity * size, nullptr, GL_STATIC_DRAW);
+        if (m_indexCount > 0) {
+            glBindBuffer(GL_COPY_READ_BUFFER, m_ebo->id());
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_ELEMENT_ARRAY_BUFFER, 0, 0, m_indexCount * size);
+        }
+        m_ebo = std::move(ebo);
+        m_indexCapacity = indexCapacity;
+    }
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    m_vao.unBind();
+    m_vbo->unBind();
+    m_ebo->unBind();
+}
+
+// Expects the VAO and the vertex buffer to be bound
+void MeshArena::pointAttributes() const
+{
+    const auto attributes = describeLayout(m_layout, 0);
+    for (GLuint location = 0; location < attributes.size(); ++location) {
+        const VertexAttribute& attribute = attributes[location];
+        const GLboolean normalized = attribute.type == AttributeType::Float ? GL_FALSE : GL_TRUE;
+        glVertexAttribPointer(location, attribute.components, toGLType(attribute.type), normalized, attribute.stride, (void*)attribute.offset);
+    }
+}
+
+void MeshArena::bind() const
+{
+    m_vao.bind();
+}
+
+void MeshArena::unBind() const
+{
+    m_vao.unBind();
+}
+
+void MeshArena::draw(const ArenaMesh& mesh) const
+{
+    if (mesh.vertexCount == 0) {
+        return;
+    }
+    setDequantization(mesh.dequantization);
+    glVertexAttrib1f(7, 0.0f);
+
+    if (mesh.indexCount == 0) {
+        glDrawArrays(mesh.primitive, mesh.baseVertex, mesh.vertexCount);
+        return;
+    }
+    const GLenum type = toGLType(m_indexType);
+    const void* offset = reinterpret_cast<const void*>(mesh.firstIndex * indexSize(m_indexType));
+    if (mesh.primitive == GL_TRIANGLE_STRIP) {
+        // The restart index is matched before baseVertex is added, so it stays the type's maximum
+        glEnable(GL_PRIMITIVE_RESTART);
+        glPrimitiveRestartIndex(restartIndex(m_indexType));
+        glDrawElementsBaseVertex(mesh.primitive, mesh.indexCount, type, offset, mesh.baseVertex);
+        glDisable(GL_PRIMITIVE_RESTART);
+    }
+    else {
+        glDrawElementsBaseVertex(mesh.primitive, mesh.indexCount, type, offset, mesh.baseVertex);
+    }
+}
+
+void MeshArena::draw(std::span<const ArenaMesh> meshes) const
+{
+    bind();
+    for (const ArenaMesh& mesh : meshes) {
+        draw(mesh);
+    }
+    unBind();
+}
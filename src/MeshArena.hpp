@@ -0,0 +1,81 @@
+#ifndef MESHARENA_H
+#define MESHARENA_H
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "VAO.hpp"
+#include "VBO.hpp"
+#include "EBO.hpp"
+#include "MeshData.hpp"
+#include "VertexLayout.hpp"
+#include "IndexFormat.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <span>
+
+// Where a mesh lives in a MeshArena. Indices stay local to the mesh and baseVertex is
+// added to them by glDrawElementsBaseVertex, so a U16 arena can hold any number of
+// meshes of up to 65535 vertices each.
+struct ArenaMesh
+{
+    std::size_t firstIndex{ 0 };  // in indices, not bytes
+    GLsizei indexCount{ 0 };      // 0: drawn with glDrawArrays from baseVertex
+    GLint baseVertex{ 0 };
+    GLsizei vertexCount{ 0 };
+    GLenum primitive{ GL_TRIANGLES };
+    Dequantization dequantization; // each mesh is quantized against its own bounds
+};
+
+// Static meshes of one vertex layout sub-allocated from a single vertex buffer and element
+// buffer behind a single VAO: drawing any number of them is one bind plus one
+// glDrawElementsBaseVertex each, with no buffer or VAO switches in between. Meshes are
+// appended and only released all together by clear(); the buffers grow by doubling, copied
+// on the GPU. Draw with default.vert (or any shader reading locations 0-3).
+class MeshArena
+{
+public:
+    // SplitPosition and Planar place each attribute by the mesh's vertex count, so meshes
+    // can't share their buffers: they throw std::invalid_argument.
+    explicit MeshArena(VertexLayout vertexLayout = VertexLayout::Interleaved, IndexType indexType = IndexType::U32);
+
+    // Uploads the mesh behind those already added. Throws std::invalid_argument when the mesh
+    // has more vertices than the index type can address.
+    ArenaMesh add(const MeshData& data);
+    void reserve(std::size_t vertexCount, std::size_t indexCount); // in vertices and indices
+    void clear(); // forgets every mesh; the buffers are kept for reuse
+
+    std::size_t vertexCount() const;
+    std::size_t indexCount() const;
+    VertexLayout layout() const;
+
+    void bind() const;
+    void unBind() const;
+
+    // Sets the mesh's dequantization and morph factor (generic attributes 4, 5 and 7) and
+    // draws it. Only between bind() and unBind(), so consecutive draws share the binding.
+    void draw(const ArenaMesh& mesh) const;
+    void draw(std::span<const ArenaMesh> meshes) const; // binds, draws each, unbinds
+
+    MeshArena(const MeshArena& other) = delete;
+    MeshArena& operator=(const MeshArena& other) = delete;
+    MeshArena(MeshArena&& other) = delete;
+    MeshArena& operator=(MeshArena&& other) = delete;
+
+private:
+    void grow(std::size_t vertexCount, std::size_t indexCount);
+    void pointAttributes() const;
+
+    VertexLayout m_layout;
+    IndexType m_indexType;
+    VAO m_vao;
+    std::unique_ptr<VBO> m_vbo;
+    std::unique_ptr<EBO> m_ebo;
+    std::size_t m_vertexCount{ 0 };
+    std::size_t m_indexCount{ 0 };
+    std::size_t m_vertexCapacity{ 0 };
+    std::size_t m_indexCapacity{ 0 };
+};
+
+#endif // MESHARENA_H
@@ -0,0 +1,182 @@
+#include "MeshCleanup.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace {
+    constexpr int attribCount = MeshData::attribCount;
+
+    std::uint64_t cellKey(std::int64_t x, std::int64_t y, std::int64_t z)
+    {
+        // 21 bits per axis; far-apart cells may share a key, which only costs a longer chain
+        constexpr std::uint64_t mask = (1u << 21) - 1;
+        return (std::uint64_t(x) & mask) | ((std::uint64_t(y) & mask) << 21) | ((std::uint64_t(z) & mask) << 42);
+    }
+
+    // Open-addressed map from cell key to the head of that cell's vertex chain.
+    class CellTable
+    {
+    public:
+        static constexpr std::uint32_t empty = std::numeric_limits<std::uint32_t>::max();
+
+        explicit CellTable(std::size_t capacity)
+        {
+            std::size_t size = 16;
+            while (size < capacity * 2) {
+                size *= 2;
+            }
+            m_keys.resize(size);
+            m_heads.assign(size, empty);
+            m_mask = size - 1;
+        }
+
+        // The chain head for key, or a reference to an empty slot that claims key when written.
+        std::uint32_t& operator[](std::uint64_t key)
+        {
+            std::size_t slot = hash(key) & m_mask;
+            while (m_heads[slot] != empty && m_keys[slot] != key) {
+                slot = (slot + 1) & m_mask;
+            }
+            m_keys[slot] = key;
+            return m_heads[slot];
+        }
+
+    private:
+        static std::size_t hash(std::uint64_t key)
+        {
+            key ^= key >> 33;
+            key *= 0xff51afd7ed558ccdull;
+            key ^= key >> 33;
+            return std::size_t(key);
+        }
+
+        std::vector<std::uint64_t> m_keys;
+        std::vector<std::uint32_t> m_heads;
+        std::size_t m_mask;
+    };
+
+    bool within(const float* a, const float* b, int count, float tolerance)
+    {
+        for (int c = 0; c < count; ++c) {
+            if (std::abs(a[c] - b[c]) > tolerance) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool sameVertex(const float* a, const float* b, const WeldOptions& options)
+    {
+        return within(a, b, 3, options.positionTolerance)
+            && (!options.compareColours || within(a + 3, b + 3, 3, options.attributeTolerance))
+            && (!options.compareTexCoords || within(a + 6, b + 6, 2, options.attributeTolerance))
+            && (!options.compareNormals || within(a + 8, b + 8, 3, options.attributeTolerance));
+    }
+}
+
+std::vector<std::uint32_t> findDuplicateVertices(std::span<const float> vertices, const WeldOptions& options)
+{
+    const std::size_t vertexCount = vertices.size() / attribCount;
+    std::vector<std::uint32_t> remap(vertexCount);
+
+    // Cells are several tolerances wide; a neighbouring cell is only searched when the
+    // vertex is within tolerance of the face they share. Each cell holds a chain of the
+    // unique vertices that landed in it.
+    const float tolerance = options.positionTolerance;
+    const float cellSize = std::max(8.0f * tolerance, std::numeric_limits<float>::min());
+    constexpr std::uint32_t end = CellTable::empty;
+    CellTable cells(vertexCount);
+    std::vector<std::uint32_t> next(vertexCount, end);
+
+    for (std::size_t v = 0; v < vertexCount; ++v) {
+        const float* vertex = &vertices[v * attribCount];
+        std::int64_t cell[3];
+        int low[3], high[3];
+        for (int c = 0; c < 3; ++c) {
+            const float scaled = vertex[c] / cellSize;
+            cell[c] = std::int64_t(std::floor(scaled));
+            const float offset = (scaled - float(cell[c])) * cellSize;
+            low[c] = offset < tolerance ? -1 : 0;
+            high[c] = offset > cellSize - tolerance ? 1 : 0;
+        }
+
+        std::uint32_t match = end;
+        for (int dx = low[0]; dx <= high[0] && match == end; ++dx) {
+            for (int dy = low[1]; dy <= high[1] && match == end; ++dy) {
+                for (int dz = low[2]; dz <= high[2] && match == end; ++dz) {
+                    for (std::uint32_t u = cells[cellKey(cell[0] + dx, cell[1] + dy, cell[2] + dz)]; u != end; u = next[u]) {
+                        if (sameVertex(vertex, &vertices[std::size_t(u) * attribCount], options)) {
+                            match = u;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (match != end) {
+            remap[v] = match;
+            continue;
+        }
+        remap[v] = std::uint32_t(v);
+        std::uint32_t& head = cells[cellKey(cell[0], cell[1], cell[2])];
+        next[v] = head;
+        head = std::uint32_t(v);
+    }
+    return remap;
+}
+
+CleanupStats cleanMesh(MeshData& mesh, const WeldOptions& options)
+{
+    CleanupStats stats;
+    if (mesh.primitive != Primitive::Triangles || mesh.indices.empty()) {
+        return stats;
+    }
+
+    const std::size_t vertexCount = mesh.vertexCount();
+    const std::vector<std::uint32_t> duplicateOf = findDuplicateVertices(mesh.vertices, options);
+
+    std::size_t written = 0;
+    std::vector<bool> used(vertexCount, false);
+    for (std::size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+        unsigned int triangle[3];
+        bool valid = true;
+        for (int c = 0; c < 3; ++c) {
+            valid = valid && mesh.indices[i + c] < vertexCount;
+            triangle[c] = valid ? duplicateOf[mesh.indices[i + c]] : 0;
+        }
+        if (!valid || triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[0] == triangle[2]) {
+            ++stats.trianglesRemoved;
+            continue;
+        }
+        for (int c = 0; c < 3; ++c) {
+            mesh.indices[written++] = triangle[c];
+            used[triangle[c]] = true;
+        }
+    }
+    mesh.indices.resize(written);
+
+    std::vector<std::uint32_t> compacted(vertexCount);
+    std::size_t kept = 0;
+    for (std::size_t v = 0; v < vertexCount; ++v) {
+        if (!used[v]) {
+            continue;
+        }
+        if (kept != v) {
+            std::memcpy(&mesh.vertices[kept * attribCount], &mesh.vertices[v * attribCount], attribCount * sizeof(float));
+        }
+        compacted[v] = std::uint32_t(kept++);
+    }
+    for (unsigned int& index : mesh.indices) {
+        index = compacted[index];
+    }
+    stats.verticesRemoved = vertexCount - kept;
+    mesh.vertices.resize(kept * attribCount);
+
+    mesh.vertices.shrink_to_fit();
+    mesh.indices.shrink_to_fit();
+    return stats;
+}
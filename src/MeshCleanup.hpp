@@ -0,0 +1,38 @@
+#ifndef MESHCLEANUP_H
+#define MESHCLEANUP_H
+
+#include "MeshData.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Which vertices count as duplicates. Positions within positionTolerance (per axis) are
+// merged if the compared attributes also agree within attributeTolerance; keeping
+// texture coordinates and normals in the comparison preserves UV seams and hard edges.
+struct WeldOptions
+{
+    float positionTolerance{ 1e-5f };
+    float attributeTolerance{ 1e-3f };
+    bool compareColours{ false }; // most shapes colour every vertex randomly, which would keep them all apart
+    bool compareTexCoords{ true };
+    bool compareNormals{ true };
+};
+
+// For every vertex, the first earlier vertex it duplicates (or itself). Positions are
+// bucketed in a hash grid, so this is linear in the vertex count.
+std::vector<std::uint32_t> findDuplicateVertices(std::span<const float> vertices, const WeldOptions& options = {});
+
+struct CleanupStats
+{
+    std::size_t verticesRemoved{ 0 };
+    std::size_t trianglesRemoved{ 0 };
+};
+
+// Welds duplicate vertices, drops triangles that become degenerate (or that index past
+// the vertices), drops vertices nothing references, and shrinks both buffers to size.
+// Vertices keep their relative order. Only triangle lists are touched.
+CleanupStats cleanMesh(MeshData& mesh, const WeldOptions& options = {});
+
+#endif // MESHCLEANUP_H
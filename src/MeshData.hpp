@@ -0,0 +1,29 @@
+#ifndef MESHDATA_H
+#define MESHDATA_H
+
+#include <cstddef>
+#include <vector>
+
+// Plain CPU-side geometry. Nothing in here touches OpenGL, so meshes can be
+// generated on any thread (or on a machine without a GPU) and uploaded later.
+
+enum class Primitive
+{
+    Points,
+    Lines,
+    Triangles,
+    TriangleStrip,  // strips are separated by MeshData::restartIndex
+};
+
+struct MeshData
+{
+    std::size_t vertexCount() const { return vertices.size() / attribCount; }
+
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;
+    Primitive primitive{ Primitive::Triangles };
+    static constexpr int attribCount = 11; // 11 == 3pos + 3col + 2tex + 3 norm
+    static constexpr unsigned int restartIndex = 0xFFFFFFFF; // narrowed with the indices on upload
+};
+
+#endif // MESHDATA_H
@@ -0,0 +1,520 @@
+#include "MeshGenerators.hpp"
+#include "ParametricSurface.hpp"
+#include "RingKernel.hpp"
+#include "VertexRandom.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <vector>
+
+namespace {
+    constexpr int attribCount = MeshData::attribCount;
+
+    // Colours are keyed on the vertex index, so any range can be filled from any thread.
+    void fillRandomColours(std::vector<float>& vertices, int begin, int end, std::uint32_t seed)
+    {
+        for (int v = begin; v < end; ++v) {
+            float* colour = &vertices[static_cast<std::size_t>(v) * attribCount + 3];
+            colour[0] = vertexRandom(seed, v, 0);
+            colour[1] = vertexRandom(seed, v, 1);
+            colour[2] = vertexRandom(seed, v, 2);
+        }
+    }
+
+    void setNormals(std::vector<float>& vertices, int begin, int end, float x, float y, float z)
+    {
+        for (std::size_t i = static_cast<std::size_t>(begin) * attribCount; i < static_cast<std::size_t>(end) * attribCount; i += attribCount) {
+            vertices[i + 8] = x;
+            vertices[i + 9] = y;
+            vertices[i + 10] = z;
+        }
+    }
+
+    constexpr float plotScale = curvePlotScale;
+
+    // Curves are drawn in red.
+    void appendCurveVertex(MeshData& mesh, float x, float y)
+    {
+        const float vertex[attribCount] = {
+            x * plotScale, y * plotScale, 0.0f,
+            1.0f, 0.0f, 0.0f,
+            0.0f, 1.0f,
+            0.0f, 0.0f, 0.0f,
+        };
+        mesh.vertices.insert(mesh.vertices.end(), vertex, vertex + attribCount);
+    }
+
+    // Appends one connected line through the (unscaled) samples of run, leaving out every
+    // sample the line passes within tolerance of anyway. The refinement never merges the
+    // segments of its starting grid; this coarsens them where the curve is flat.
+    void appendCurveRun(MeshData& mesh, std::span<const std::array<float, 2>> run, float tolerance)
+    {
+        if (run.size() < 2) {
+            return;
+        }
+        auto chordHolds = [&](std::size_t first, std::size_t last) {
+            const float cx = (run[last][0] - run[first][0]) * plotScale;
+            const float cy = (run[last][1] - run[first][1]) * plotScale;
+            const float length = std::sqrt(cx * cx + cy * cy);
+            for (std::size_t i = first + 1; i < last; ++i) {
+                const float px = (run[i][0] - run[first][0]) * plotScale;
+                const float py = (run[i][1] - run[first][1]) * plotScale;
+                if (std::abs(cx * py - cy * px) > tolerance * length) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        appendCurveVertex(mesh, run[0][0], run[0][1]);
+        std::size_t anchor = 0;
+        for (std::size_t i = 1; i < run.size(); ++i) {
+            if (i + 1 < run.size() && chordHolds(anchor, i + 1)) {
+                continue;
+            }
+            const unsigned int index = static_cast<unsigned int>(mesh.vertexCount());
+            appendCurveVertex(mesh, run[i][0], run[i][1]);
+            mesh.indices.push_back(index - 1);
+            mesh.indices.push_back(index);
+            anchor = i;
+        }
+    }
+}
+
+MeshData generateCoordinateAxes()
+{
+    MeshData mesh;
+    float r = 10.0f;
+    mesh.vertices = {
+        0.0f, 0.0f, 0.0f,   1.0f, 1.0f, 1.0f,      0.0f, 1.0f,      0.0f, 0.0f, 1.0f,       //  2
+        r, 0.0f, 0.0f,      1.0f, 0.0f, 0.0f,      0.0f, 1.0f,      0.0f, 0.0f, 1.0f,       //  | 3
+        0.0f, r, 0.0f,      0.0f, 1.0f, 0.0f,      0.0f, 0.0f,      0.0f, 0.0f, 1.0f,       //  |/
+        0.0f, 0.0f, r,      0.0f, 0.0f, 1.0f,      1.0f, 1.0f,      0.0f, 0.0f, 1.0f,       //  0-----1
+    };
+
+    mesh.primitive = Primitive::Lines;
+    mesh.indices = {
+        0, 1,
+        0, 2,
+        0, 3
+    };
+
+    return mesh;
+}
+
+MeshData generateRectangle(float height, float width)
+{
+    MeshData mesh;
+    mesh.vertices = {
+        -width / 2.0f, height / 2.0f, 0.0f,      1.0f, 0.0f, 0.0f,      0.0f, 1.0f,      0.0f, 0.0f, 1.0f,
+        -width / 2.0f, -height / 2.0f, 0.0f,     0.0f, 1.0f, 0.0f,      0.0f, 0.0f,      0.0f, 0.0f, 1.0f,     //  0-------2
+        width / 2.0f, height / 2.0f, 0.0f,       0.0f, 0.0f, 1.0f,      1.0f, 1.0f,      0.0f, 0.0f, 1.0f,     //  |       |
+        width / 2.0f, -height / 2.0f, 0.0f,      1.0f, 1.0f, 0.0f,      1.0f, 0.0f,      0.0f, 0.0f, 1.0f      //  1-------3
+    };
+
+    mesh.indices = {
+        0, 1, 2,
+        1, 3, 2
+    };
+
+    return mesh;
+}
+
+MeshData generateCuboid(float width, float height, float depth)
+{
+    MeshData mesh;
+    mesh.vertices = {
+        -width / 2.0f, height / 2.0f, depth / 2.0f,     1.0f, 0.0f, 0.0f,       0.0f, 1.0f,      0.0f, 0.0f, 1.0f, //front 0
+        -width / 2.0f, -height / 2.0f, depth / 2.0f,    0.0f, 1.0f, 0.0f,       0.0f, 0.0f,      0.0f, 0.0f, 1.0f,
+        width / 2.0f, height / 2.0f, depth / 2.0f,      0.0f, 0.0f, 1.0f,       1.0f, 1.0f,      0.0f, 0.0f, 1.0f,
+        width / 2.0f, -height / 2.0f, depth / 2.0f,     1.0f, 1.0f, 0.0f,       1.0f, 0.0f,      0.0f, 0.0f, 1.0f,
+
+        -width / 2.0f, height / 2.0f, -depth / 2.0f,    1.0f, 0.0f, 0.0f,       0.0f, 1.0f,      0.0f, 0.0f, -1.0f, //back 4
+        -width / 2.0f, -height / 2.0f, -depth / 2.0f,   0.0f, 1.0f, 0.0f,       0.0f, 0.0f,      0.0f, 0.0f, -1.0f,
+        width / 2.0f, height / 2.0f, -depth / 2.0f,     0.0f, 0.0f, 1.0f,       1.0f, 1.0f,      0.0f, 0.0f, -1.0f,
+        width / 2.0f, -height / 2.0f, -depth / 2.0f,    1.0f, 1.0f, 0.0f,       1.0f, 0.0f,      0.0f, 0.0f, -1.0f,
+
+        -width / 2.0f, height / 2.0f, -depth / 2.0f,    1.0f, 0.0f, 0.0f,       0.0f, 1.0f,      -1.0f, 0.0f, 0.0f, //left 8
+        -width / 2.0f, -height / 2.0f, -depth / 2.0f,   0.0f, 1.0f, 0.0f,       0.0f, 0.0f,      -1.0f, 0.0f, 0.0f,
+        -width / 2.0f, height / 2.0f, depth / 2.0f,     1.0f, 0.0f, 0.0f,       1.0f, 1.0f,      -1.0f, 0.0f, 0.0f,
+        -width / 2.0f, -height / 2.0f, depth / 2.0f,    0.0f, 1.0f, 0.0f,       1.0f, 0.0f,      -1.0f, 0.0f, 0.0f,
+
+        width / 2.0f, height / 2.0f, depth / 2.0f,      0.0f, 0.0f, 1.0f,       0.0f, 1.0f,     1.0f, 0.0f, 0.0f, //right 12
+        width / 2.0f, -height / 2.0f, depth / 2.0f,     1.0f, 1.0f, 0.0f,       0.0f, 0.0f,     1.0f, 0.0f, 0.0f,
+        width / 2.0f, height / 2.0f, -depth / 2.0f,     0.0f, 0.0f, 1.0f,       1.0f, 1.0f,     1.0f, 0.0f, 0.0f,
+        width / 2.0f, -height / 2.0f, -depth / 2.0f,    1.0f, 1.0f, 0.0f,       1.0f, 0.0f,     1.0f, 0.0f, 0.0f,
+
+        -width / 2.0f, height / 2.0f, -depth / 2.0f,    1.0f, 0.0f, 0.0f,       0.0f, 1.0f,     0.0f, 1.0f, 0.0f, //top 16
+        -width / 2.0f, height / 2.0f, depth / 2.0f,     1.0f, 0.0f, 0.0f,       0.0f, 0.0f,     0.0f, 1.0f, 0.0f,                    //  16       18
+        width / 2.0f, height / 2.0f, -depth / 2.0f,     0.0f, 0.0f, 1.0f,       1.0f, 1.0f,     0.0f, 1.0f, 0.0f,                    //     8 4--------6 14
+        width / 2.0f, height / 2.0f, depth / 2.0f,      0.0f, 0.0f, 1.0f,       1.0f, 0.0f,     0.0f, 1.0f, 0.0f,                    //      /|       /|
+                                                                                                                                        //  10 0--------2 | 12
+        -width / 2.0f, -height / 2.0f, -depth / 2.0f,   0.0f, 1.0f, 0.0f,       0.0f, 1.0f,     0.0f, -1.0f, 0.0f, //bottom 20       //     | |      | |
+        -width / 2.0f, -height / 2.0f, depth / 2.0f,    0.0f, 1.0f, 0.0f,       0.0f, 0.0f,     0.0f, -1.0f, 0.0f,                   //    9| 5------|-7 15
+        width / 2.0f, -height / 2.0f, -depth / 2.0f,    1.0f, 1.0f, 0.0f,       1.0f, 1.0f,     0.0f, -1.0f, 0.0f,                   //     |/       |/
+        width / 2.0f, -height / 2.0f, depth / 2.0f,     1.0f, 1.0f, 0.0f,       1.0f, 0.0f,     0.0f, -1.0f, 0.0f                    //  11 1--------3 13
+    };
+
+    mesh.indices = {
+        0, 1, 2,        1, 3, 2,
+        6, 7, 5,        5, 4, 6,
+        8, 9, 11,       11, 10, 8,
+        12, 13, 15,     15, 14, 12,
+        16, 17, 18,     17, 19, 18,
+        20, 21, 22,     21, 23, 22
+    };
+
+    return mesh;
+}
+
+MeshData generateCircle(int n, float r, std::uint32_t seed)
+{
+    MeshData mesh;
+    // n steps requires n+1 verts including middle
+    mesh.vertices = { 0.0f, 0.0f, 0.0f,    0.0f, 1.0f, 0.0f,   0.5f, 0.5f,   0.0f, 0.0f, -1.0f }; // middle vertex
+    mesh.vertices.resize(attribCount * (n + 1));
+    fillRandomColours(mesh.vertices, 1, n + 1, seed);
+    setNormals(mesh.vertices, 1, n + 1, 0.0f, 0.0f, -1.0f);
+
+    const RingTerm ring[] = {
+        { 0, r, 0.0f, 0.0f },
+        { 1, 0.0f, r, 0.0f },
+        { 6, 0.5f, 0.0f, 0.5f },
+        { 7, 0.0f, 0.5f, 0.5f },
+    };
+    emitRing(&mesh.vertices[attribCount], n, ringTable(n), ring);
+
+    // need 3n indices
+    mesh.indices.resize(3 * n);
+    mesh.indices[0] = 0;
+    mesh.indices[1] = 1;
+    mesh.indices[2] = 2;
+    for (int i = 3; i < mesh.indices.size(); i += 3) {
+        mesh.indices[i] = 0;
+        mesh.indices[i + 1] = mesh.indices[i - 1];
+        mesh.indices[i + 2] = mesh.indices[i - 1] + 1;
+    }
+    mesh.indices[mesh.indices.size() - 1] = mesh.indices[1];
+
+    return mesh;
+}
+
+MeshData generateCylinder(int n, float r, std::uint32_t seed)
+{
+    MeshData mesh;
+    // n steps requires n+1 verts including middle
+    mesh.vertices.resize(attribCount * (n + 1) * 2);
+    float h = 1.0f;
+    const int top = 2 * n + 1;
+
+    //bottom middle, bottom circle 1..n, top circle n+1..2n, top middle
+    fillRandomColours(mesh.vertices, 0, top, seed);
+    setNormals(mesh.vertices, 0, top + 1, 0.0f, 0.0f, -1.0f);
+
+    mesh.vertices[1] = -h;
+    mesh.vertices[6] = 0.5f;
+    mesh.vertices[7] = 0.5f;
+
+    const RingTable& table = ringTable(n);
+    const RingTerm bottom[] = {
+        { 0, r, 0.0f, 0.0f },
+        { 1, 0.0f, 0.0f, -h },
+        { 2, 0.0f, r, 0.0f },
+        { 6, 0.5f, 0.0f, 0.5f },
+        { 7, 0.0f, 0.0f, (-h / r + 1.0f) * 0.5f },
+    };
+    emitRing(&mesh.vertices[attribCount], n, table, bottom);
+
+    const RingTerm topRing[] = {
+        { 0, r, 0.0f, 0.0f },
+        { 1, 0.0f, 0.0f, h },
+        { 2, 0.0f, r, 0.0f },
+        { 6, 0.5f, 0.0f, 0.5f },
+        { 7, 0.0f, 0.0f, (h / r + 1.0f) * 0.5f },
+    };
+    emitRing(&mesh.vertices[(n + 1) * attribCount], n, table, topRing);
+
+    mesh.vertices[top * attribCount + 1] = h;
+    mesh.vertices[top * attribCount + 6] = 0.5f;
+    mesh.vertices[top * attribCount + 7] = 0.5f;
+
+    int i;
+    // need 3n indices
+    mesh.indices.resize(3 * n + 6 * n + 3 * n);
+
+    // bottom
+    // indices[0] = 0   indices[1] = 1   indices[2] = 2             // n=6 => points = 18
+    // indices[3] = 0   indices[4] = 2   indices[5] = 3             //
+    // indices[6] = 0   indices[7] = 3   indices[8] = 4             //       3______2
+    // indices[9] = 0   indices[10] = 4  indices[11] = 5            //       /      \
+    // indices[12] = 0  indices[13] = 5  indices[14] = 6            //     4/   0    \ 1
+    // indices[12] = 0  indices[13] = 5  indices[14] = 6            //      \        /
+    // indices[15] = 0  indices[16] = 6  indices[17 == 3n-1] = 1    //      5\______/6
+
+    int l = 1;
+    for (i = 0; i < 3*(n-1); i += 3, ++l) {
+        mesh.indices[i] = 0;             // indices[0] to indices[3n-6]
+        mesh.indices[i + 1] = l;         // indices[1] to indices[3n-5]
+        mesh.indices[i + 2] = l + 1;     // indices[2] to indices[3n-4]
+    }
+    mesh.indices[i] = 0;         // indices[3n-3]
+    mesh.indices[i + 1] = l;     // indices[3n-2]
+    mesh.indices[i + 2] = 1;     // indices[3n-1]
+
+    // hollow cone side
+    // indices[18 == 3n] = 7    indices[21] = 2     //       n=6 => points = 18 + 36
+    // indices[19] = 1          indices[22] = 8     //
+    // indices[20] = 2          indices[23] = 7     //       9______8
+                                                    //       /      \
+    // indices[24] = 8          indices[27] = 3     //    10/   13   \7
+    // indices[25] = 2          indices[28] = 9     //      \        /
+    // indices[26] = 3          indices[29] = 8     //     11\______/12
+
+    // indices[30] = 9          indices[33] = 4
+    // indices[31] = 3          indices[34] = 10
+    // indices[32] = 4          indices[35] = 9
+
+    // indices[36] = 10         indices[39] = 5     //       3______2
+    // indices[37] = 4          indices[40] = 11    //       /      \
+    // indices[38] = 5          indices[41] = 10    //     4/   0    \1
+                                                    //      \        /
+    // indices[42] = 11         indices[45] = 6     //      5\______/6
+    // indices[43] = 5          indices[46] = 12
+    // indices[44] = 6          indices[47] = 11
+
+    // indices[48] = 12         indices[51] = 1
+    // indices[49] = 6          indices[52] = 7
+    // indices[50] = 1          indices[53 == 18 + 2(18)-1 == 3n + 2(3n)-1] = 12
+
+    for (i = 3 * n, l = 1; i < (3 * n + 2 * 3 * n - 6); i += 6, ++l) {
+        mesh.indices[i] = n + l;             // indices[3n] to indices[3n + 2(3n)-6]
+        mesh.indices[i + 1] = l;             // indices[3n+1] to indices[3n + 2(3n)-5]
+        mesh.indices[i + 2] = l + 1;         // indices[3n+2] to indices[3n + 2(3n)-4]
+
+        mesh.indices[i + 3] = l + 1;         // indices[3n+3] to indices[3n + 2(3n)-3]
+        mesh.indices[i + 4] = n + l + 1;     // indices[3n+4] to indices[3n + 2(3n)-2]
+        mesh.indices[i + 5] = n + l;         // indices[3n+5] to indices[3n + 2(3n)-1]
+    }
+    mesh.indices[i] = 2*n-(n-1); // redo last triangle
+    mesh.indices[i + 1] = n;
+    mesh.indices[i + 2] = 1;
+
+    mesh.indices[i + 3] = 2*n; // redo last triangle
+    mesh.indices[i + 4] = 2 * n - (n - 1);
+    mesh.indices[i + 5] = n;
+
+    //top
+    // n = 6 = > points = 18 + 36 + 18 = 72
+    int k = 3 * n + 2 * 3 * n;
+    for (i = 0, l = 1; i < 3 * (n - 1); i += 3, ++l) {
+        mesh.indices[k + i] = (n + 1) * 2 - 1;   // indices[3n + 2(3)n] to indices[3n-5] = last vertex
+        mesh.indices[k + i + 1] = n + l;         // indices[3n + 2(3)n + 1] to indices[3n-5]
+        mesh.indices[k + i + 2] = n + l + 1;     // indices[3n + 2(3)n + 2] to indices[3n-4]
+    }
+    mesh.indices[k + i] = (n + 1) * 2 - 1;       // last vertex
+    mesh.indices[k + i + 1] = n+l;               // indices[3n-2]
+    mesh.indices[k + i + 2] = n+1;               // indices[3n-1]
+
+    return mesh;
+}
+
+MeshData generatePolynomial(float a, float b, float c, float d, float e, float r, float s, float low, float high, int n, bool ySquared)
+{
+    MeshData mesh;
+    mesh.primitive = Primitive::Lines;
+    if (n < 2) {
+        return mesh;
+    }
+
+    const float dx = (high - low) / float(n - 1);
+    std::vector<float> x(n);
+    std::vector<float> y(n);
+    for (int i = 0; i < n; ++i) {
+        x[i] = low + i * dx;
+    }
+    const Polynomial polynomial{ a, b, c, d, e, r, s, ySquared };
+    evaluatePolynomial(polynomial, x.data(), y.data(), n);
+
+    mesh.vertices.reserve(static_cast<std::size_t>(n) * attribCount);
+    mesh.indices.reserve(2 * static_cast<std::size_t>(n));
+    bool joined = false; // the previous sample was emitted
+    for (int i = 0; i < n; ++i) {
+        if (!std::isfinite(y[i])) {
+            joined = false;
+            continue;
+        }
+        if (i > 0 && polynomial.hasPole() && x[i - 1] < 0.0f && x[i] > 0.0f) {
+            joined = false; // stepped over the pole
+        }
+        const unsigned int index = static_cast<unsigned int>(mesh.vertexCount());
+        appendCurveVertex(mesh, x[i], y[i]);
+        if (joined) {
+            mesh.indices.push_back(index - 1);
+            mesh.indices.push_back(index);
+        }
+        joined = true;
+    }
+    return mesh;
+}
+
+MeshData generateAdaptivePolynomial(const Polynomial& polynomial, float low, float high, const PolynomialSampling& sampling)
+{
+    struct Segment
+    {
+        float x0, y0, x1, y1;
+    };
+
+    MeshData mesh;
+    mesh.primitive = Primitive::Lines;
+    const int initial = std::max(1, sampling.initialSegments);
+    if (!(high > low)) {
+        return mesh;
+    }
+
+    auto defined = [&](float y) { return std::isfinite(y) && std::abs(y * plotScale) <= sampling.clip; };
+
+    // the pole gets a sample of its own so no segment straddles it
+    std::vector<float> x(initial + 1);
+    for (int i = 0; i <= initial; ++i) {
+        x[i] = low + (high - low) * float(i) / float(initial);
+    }
+    if (polynomial.hasPole() && low < 0.0f && high > 0.0f) {
+        x.insert(std::upper_bound(x.begin(), x.end(), 0.0f), 0.0f);
+        x.erase(std::unique(x.begin(), x.end()), x.end());
+    }
+    std::vector<float> y(x.size());
+    evaluatePolynomial(polynomial, x.data(), y.data(), x.size());
+
+    std::vector<Segment> pending;
+    for (std::size_t i = 0; i + 1 < x.size(); ++i) {
+        pending.push_back({ x[i], y[i], x[i + 1], y[i + 1] });
+    }
+
+    // Breadth first, so each level's midpoints are evaluated in one batch.
+    std::vector<Segment> kept;
+    std::vector<Segment> next;
+    std::vector<float> middleX, middleY;
+    for (int depth = 0; !pending.empty(); ++depth) {
+        middleX.resize(pending.size());
+        middleY.resize(pending.size());
+        for (std::size_t i = 0; i < pending.size(); ++i) {
+            middleX[i] = 0.5f * (pending[i].x0 + pending[i].x1);
+        }
+        evaluatePolynomial(polynomial, middleX.data(), middleY.data(), pending.size());
+
+        next.clear();
+        for (std::size_t i = 0; i < pending.size(); ++i) {
+            const Segment& segment = pending[i];
+            const float xm = middleX[i];
+            const float ym = middleY[i];
+            const bool start = defined(segment.y0);
+            const bool end = defined(segment.y1);
+            const bool middle = defined(ym);
+            if (!start && !middle && !end) {
+                continue; // nothing to draw here
+            }
+            const bool ends = start && end;
+
+            bool split = !ends || !middle; // closes in on where the curve stops or starts
+            if (!split) {
+                // distance of the midpoint from the chord, in plotted units
+                const float cx = (segment.x1 - segment.x0) * plotScale;
+                const float cy = (segment.y1 - segment.y0) * plotScale;
+                const float mx = (xm - segment.x0) * plotScale;
+                const float my = (ym - segment.y0) * plotScale;
+                const float length = std::sqrt(cx * cx + cy * cy);
+                split = std::abs(cx * my - cy * mx) > sampling.tolerance * length;
+            }
+            if (split && depth < sampling.maxDepth) {
+                next.push_back({ segment.x0, segment.y0, xm, ym });
+                next.push_back({ xm, ym, segment.x1, segment.y1 });
+            }
+            else if (ends && middle) {
+                kept.push_back(segment);
+            }
+        }
+        pending.swap(next);
+    }
+
+    // Kept segments are disjoint; joined ones share an end sample exactly and form a run.
+    std::sort(kept.begin(), kept.end(), [](const Segment& l, const Segment& r) { return l.x0 < r.x0; });
+    std::vector<std::array<float, 2>> run;
+    for (const Segment& segment : kept) {
+        if (run.empty() || segment.x0 != run.back()[0]) {
+            appendCurveRun(mesh, run, sampling.tolerance);
+            run.assign(1, { segment.x0, segment.y0 });
+        }
+        run.push_back({ segment.x1, segment.y1 });
+    }
+    appendCurveRun(mesh, run, sampling.tolerance);
+    return mesh;
+}
+
+MeshData generateCone(int n, float r, std::uint32_t seed)
+{
+    MeshData mesh;
+    //n steps requires n+2 verts including both middles
+    mesh.vertices.resize(attribCount * (n + 2));
+    float h = 1.0f;
+
+    mesh.vertices[0] = 0.0f;
+    mesh.vertices[1] = h;
+    mesh.vertices[2] = 0.0f;
+
+    mesh.vertices[3] = 0.0f;
+    mesh.vertices[4] = 1.0f;
+    mesh.vertices[5] = 0.0f;
+
+    mesh.vertices[6] = 0.5f;
+    mesh.vertices[7] = 0.5f;
+
+    fillRandomColours(mesh.vertices, 1, n + 2, seed);
+    setNormals(mesh.vertices, 0, n + 2, 0.0f, 0.0f, -1.0f);
+
+    // ring wraps back onto angle 0 for its last vertex
+    const RingTerm ring[] = {
+        { 0, r, 0.0f, 0.0f },
+        { 1, 0.0f, 0.0f, -h },
+        { 2, 0.0f, r, 0.0f },
+        { 6, 0.5f, 0.0f, 0.5f },
+        { 7, 0.0f, 0.0f, (-h / r + 1.0f) * 0.5f },
+    };
+    emitRing(&mesh.vertices[attribCount], n + 1, ringTable(n), ring);
+
+    //need 3n indices
+    mesh.indices.resize(3 * n);
+
+    mesh.indices[0] = 0;
+    mesh.indices[1] = 1;
+    mesh.indices[2] = 2;
+    for (int i = 3; i < mesh.indices.size(); i += 3) {
+        mesh.indices[i] = 0;
+        mesh.indices[i + 1] = mesh.indices[i - 1];
+        mesh.indices[i + 2] = mesh.indices[i - 1] + 1;
+    }
+    mesh.indices[mesh.indices.size() - 1] = mesh.indices[1];
+
+    return mesh;
+}
+
+MeshData generateSphere(int n, float r, std::uint32_t seed, const GenerateOptions& options)
+{
+    // n vertices per ring (no seam column), n + 1 rings from pole to pole
+    return generateParametricSurface(SphereSurface{ r }, { n, n + 1, false }, seed, options);
+}
+
+MeshData generateTorus(int n, float R, std::uint32_t seed, const GenerateOptions& options)
+{
+    return generateParametricSurface(TorusSurface{ R, R / 2 }, { n, n, true }, seed, options);
+}
+
+MeshData generateStarTorus(int n, float R, std::uint32_t seed, const GenerateOptions& options)
+{
+    // the star comes from stepping the tube angle attribCount columns per vertex
+    return generateParametricSurface(TorusSurface{ R, R / 2 }, { n, n, true, attribCount }, seed, options);
+}
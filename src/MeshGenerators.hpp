@@ -0,0 +1,69 @@
+#ifndef MESHGENERATORS_H
+#define MESHGENERATORS_H
+
+#include "MeshData.hpp"
+#include "PolynomialKernel.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// Pure CPU shape generators. Each returns interleaved vertices in the
+// MeshData::attribCount layout; upload happens separately in ShapeMesh.
+// Shapes with random vertex colours take a seed; equal seeds give equal meshes.
+
+// Controls how the grid shapes (sphere, tori) split their row loops across
+// ThreadPool::shared(), and how they index their quads. Output is byte-identical
+// whatever the thread count.
+struct GenerateOptions
+{
+    unsigned threads{ 1 };                      // 1 == serial, 0 == one per hardware thread
+    std::size_t minVerticesPerTask{ 16384 };    // meshes under two tasks' worth stay single-threaded
+    bool triangleStrips{ false };               // one restart-separated strip per row (~2 indices/quad) instead of a list (6)
+};
+
+MeshData generateCoordinateAxes();
+
+MeshData generateRectangle(float height, float width);
+
+MeshData generateCuboid(float width, float height, float depth);
+
+MeshData generateCircle(int n, float r = 1.0f, std::uint32_t seed = 0);
+
+MeshData generateCylinder(int n, float r = 0.8f, std::uint32_t seed = 0);
+
+// Polynomial curves are plotted with x and y scaled by this.
+constexpr float curvePlotScale = 0.15f;
+
+// ax^4 + bx^3 + cx^2 + dx + e + r/x + s/x^2    // low < x < high    // n points    // given in y^2
+// Samples where the curve is undefined are left out and break the line there.
+MeshData generatePolynomial(float a, float b, float c, float d, float e, float r, float s, float low, float high, int n, bool ySquared);
+
+// How generateAdaptivePolynomial places its samples. Distances are in plotted units.
+//  tolerance: how far the curve may stray from its line segments
+//  clip: |y| past which a segment ends, so poles stop at the edge of the plot
+//  initialSegments: the uniform grid refinement starts from; features narrower than one
+//      of its segments can be missed
+//  maxDepth: how many times a segment may be halved
+struct PolynomialSampling
+{
+    float tolerance{ 0.0005f };
+    float clip{ 10.0f };
+    int initialSegments{ 32 };
+    int maxDepth{ 16 };
+};
+
+// As generatePolynomial, but segments are halved only where their midpoint strays more than
+// the tolerance, so flat stretches take a handful of vertices and bends take many. The line
+// breaks wherever the curve is undefined or clipped (the pole at x = 0, a negative y^2), with
+// its ends found by bisection rather than written as huge values.
+MeshData generateAdaptivePolynomial(const Polynomial& polynomial, float low, float high, const PolynomialSampling& sampling = {});
+
+MeshData generateCone(int n, float r = 1.0f, std::uint32_t seed = 0);
+
+MeshData generateSphere(int n, float r = 1.0f, std::uint32_t seed = 0, const GenerateOptions& options = {});
+
+MeshData generateTorus(int n, float R = 0.5f, std::uint32_t seed = 0, const GenerateOptions& options = {});
+
+MeshData generateStarTorus(int n, float R = 0.5f, std::uint32_t seed = 0, const GenerateOptions& options = {});
+
+#endif // MESHGENERATORS_H
@@ -0,0 +1,509 @@
+#include "MeshOptimizer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numbers>
+#include <numeric>
+#include <vector>
+
+namespace {
+    constexpr int attribCount = MeshData::attribCount;
+
+    // Forsyth, "Linear-Speed Vertex Cache Optimisation" (2006), with his suggested constants.
+    constexpr int cacheSize = 16;
+    constexpr int maxValence = 32;
+    constexpr float cacheDecayPower = 1.5f;
+    constexpr float lastTriangleScore = 0.75f;
+    constexpr float valenceBoostScale = 2.0f;
+    constexpr float valenceBoostPower = 0.5f;
+
+    struct ScoreTables
+    {
+        std::array<float, cacheSize + 1> cache{}; // [cacheSize] is "not in cache"
+        std::array<float, maxValence + 1> valence{};
+
+        ScoreTables()
+        {
+            for (int position = 0; position < cacheSize; ++position) {
+                cache[position] = position < 3
+                    ? lastTriangleScore
+                    : std::pow(1.0f - float(position - 3) / (cacheSize - 3), cacheDecayPower);
+            }
+            for (int count = 1; count <= maxValence; ++count) {
+                valence[count] = valenceBoostScale * std::pow(float(count), -valenceBoostPower);
+            }
+        }
+
+        float score(int cachePosition, std::uint32_t remaining) const
+        {
+            if (remaining == 0) {
+                return -1.0f;
+            }
+            return cache[cachePosition] + valence[std::min<std::uint32_t>(remaining, maxValence)];
+        }
+    };
+
+    const ScoreTables& scoreTables()
+    {
+        static const ScoreTables tables;
+        return tables;
+    }
+
+    std::size_t referencedCount(std::span<const std::uint32_t> indices, std::size_t vertexCount)
+    {
+        for (std::uint32_t index : indices) {
+            vertexCount = std::max<std::size_t>(vertexCount, std::size_t(index) + 1);
+        }
+        return vertexCount;
+    }
+
+    struct Vec3
+    {
+        float x, y, z;
+    };
+
+    Vec3 operator-(Vec3 a, Vec3 b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+    Vec3 operator+(Vec3 a, Vec3 b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+    Vec3 operator*(Vec3 a, float s) { return { a.x * s, a.y * s, a.z * s }; }
+    float dot(Vec3 a, Vec3 b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    Vec3 cross(Vec3 a, Vec3 b) { return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
+    float length(Vec3 a) { return std::sqrt(dot(a, a)); }
+
+    // Reads the position of a triangle's vertices; false if any index is past the end.
+    bool trianglePositions(std::span<const float> vertices, const std::uint32_t* triangle, Vec3 (&positions)[3])
+    {
+        const std::size_t vertexCount = vertices.size() / attribCount;
+        for (int c = 0; c < 3; ++c) {
+            if (triangle[c] >= vertexCount) {
+                return false;
+            }
+            const float* p = &vertices[std::size_t(triangle[c]) * attribCount];
+            positions[c] = { p[0], p[1], p[2] };
+        }
+        return true;
+    }
+
+    // +1 if cross(p1 - p0, p2 - p0) points out of the mesh, -1 if it points in. The shapes
+    // are not all wound the same way, so this is read off the sign of the enclosed volume.
+    float outwardWinding(std::span<const std::uint32_t> indices, std::span<const float> vertices)
+    {
+        double volume = 0.0;
+        for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+            Vec3 p[3];
+            if (trianglePositions(vertices, &indices[i], p)) {
+                volume += dot(p[0], cross(p[1], p[2]));
+            }
+        }
+        return volume < 0.0 ? -1.0f : 1.0f;
+    }
+
+    // A vertex is in the FIFO if fewer than size misses happened since it was loaded.
+    class FifoCache
+    {
+    public:
+        FifoCache(std::size_t vertexCount, int size)
+            : m_loadedAt(vertexCount, 0)
+            , m_size(size)
+        {
+        }
+
+        bool load(std::uint32_t vertex) // true on a miss
+        {
+            if (m_loadedAt[vertex] != 0 && m_time - m_loadedAt[vertex] < std::size_t(m_size)) {
+                return false;
+            }
+            m_loadedAt[vertex] = ++m_time;
+            return true;
+        }
+
+        void flush()
+        {
+            m_time += m_size;
+        }
+
+    private:
+        std::vector<std::size_t> m_loadedAt;
+        std::size_t m_time{ 0 };
+        int m_size;
+    };
+}
+
+VertexCacheStats analyzeVertexCache(std::span<const std::uint32_t> indices, std::size_t vertexCount, int cacheSize)
+{
+    vertexCount = referencedCount(indices, vertexCount);
+
+    FifoCache cache(vertexCount, cacheSize);
+    std::vector<bool> referenced(vertexCount, false);
+    std::size_t misses = 0;
+    std::size_t unique = 0;
+    for (std::uint32_t index : indices) {
+        if (!referenced[index]) {
+            referenced[index] = true;
+            ++unique;
+        }
+        misses += cache.load(index);
+    }
+
+    VertexCacheStats stats;
+    stats.transformed = misses;
+    const std::size_t triangles = indices.size() / 3;
+    stats.acmr = triangles > 0 ? double(misses) / triangles : 0.0;
+    stats.atvr = unique > 0 ? double(misses) / unique : 0.0;
+    return stats;
+}
+
+void optimizeVertexCache(std::span<std::uint32_t> indices, std::size_t vertexCount)
+{
+    const std::size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) {
+        return;
+    }
+    vertexCount = referencedCount(indices, vertexCount);
+    const ScoreTables& tables = scoreTables();
+
+    // Triangles around each vertex; emitted ones are compacted out lazily when the vertex is rescored.
+    std::vector<std::uint32_t> remaining(vertexCount, 0);
+    for (std::size_t i = 0; i < triangleCount * 3; ++i) {
+        ++remaining[indices[i]];
+    }
+    std::vector<std::uint32_t> adjacencyOffset(vertexCount + 1, 0);
+    for (std::size_t v = 0; v < vertexCount; ++v) {
+        adjacencyOffset[v + 1] = adjacencyOffset[v] + remaining[v];
+    }
+    std::vector<std::uint32_t> adjacency(triangleCount * 3);
+    {
+        std::vector<std::uint32_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+        for (std::size_t i = 0; i < triangleCount * 3; ++i) {
+            adjacency[fill[indices[i]]++] = std::uint32_t(i / 3);
+        }
+    }
+    std::vector<std::uint32_t> adjacencyCount(remaining);
+
+    std::vector<float> vertexScore(vertexCount);
+    for (std::size_t v = 0; v < vertexCount; ++v) {
+        vertexScore[v] = tables.score(cacheSize, remaining[v]);
+    }
+    std::vector<float> triangleScore(triangleCount);
+    for (std::size_t t = 0; t < triangleCount; ++t) {
+        triangleScore[t] = vertexScore[indices[3 * t]] + vertexScore[indices[3 * t + 1]] + vertexScore[indices[3 * t + 2]];
+    }
+
+    std::vector<std::uint8_t> emitted(triangleCount, 0);
+    std::vector<std::uint32_t> output;
+    output.reserve(triangleCount * 3);
+
+    std::array<std::uint32_t, cacheSize + 3> cache{};
+    std::array<std::uint32_t, cacheSize + 3> nextCache{};
+    int cacheCount = 0;
+
+    std::size_t cursor = 0; // dead ends restart from the first unemitted triangle in input order
+    std::size_t best = 0;
+    for (std::size_t written = 0; written < triangleCount; ++written) {
+        if (best == triangleCount) {
+            while (emitted[cursor]) {
+                ++cursor;
+            }
+            best = cursor;
+        }
+
+        const std::uint32_t* triangle = &indices[3 * best];
+        output.insert(output.end(), triangle, triangle + 3);
+        emitted[best] = 1;
+
+        int nextCount = 0;
+        for (int c = 0; c < 3; ++c) {
+            const std::uint32_t v = triangle[c];
+            if (std::find(nextCache.begin(), nextCache.begin() + nextCount, v) == nextCache.begin() + nextCount) {
+                nextCache[nextCount++] = v;
+            }
+            --remaining[v];
+        }
+        for (int c = 0; c < cacheCount; ++c) {
+            const std::uint32_t v = cache[c];
+            if (v != triangle[0] && v != triangle[1] && v != triangle[2]) {
+                nextCache[nextCount++] = v;
+            }
+        }
+        std::swap(cache, nextCache);
+        cacheCount = nextCount;
+
+        // Rescore everything that moved in the cache (or fell out of it) and pick the
+        // best triangle touching the cache.
+        best = triangleCount;
+        float bestScore = -1.0f;
+        for (int c = 0; c < cacheCount; ++c) {
+            const std::uint32_t v = cache[c];
+            if (remaining[v] > maxValence) {
+                continue; // hubs (fan centres) keep a stale score: rescoring them every step is quadratic
+            }
+            const int position = c < cacheSize ? c : cacheSize;
+            const float score = tables.score(position, remaining[v]);
+            const float delta = score - vertexScore[v];
+            vertexScore[v] = score;
+
+            // compacts emitted triangles out of v's list as it goes
+            std::uint32_t* live = &adjacency[adjacencyOffset[v]];
+            std::uint32_t kept = 0;
+            for (std::uint32_t k = 0; k < adjacencyCount[v]; ++k) {
+                const std::uint32_t t = live[k];
+                if (emitted[t]) {
+                    continue;
+                }
+                live[kept++] = t;
+                triangleScore[t] += delta;
+                if (triangleScore[t] > bestScore) {
+                    bestScore = triangleScore[t];
+                    best = t;
+                }
+            }
+            adjacencyCount[v] = kept;
+        }
+        cacheCount = std::min(cacheCount, cacheSize);
+    }
+
+    std::copy(output.begin(), output.end(), indices.begin());
+}
+
+void optimizeVertexFetch(std::vector<float>& vertices, std::span<std::uint32_t> indices)
+{
+    const std::size_t vertexCount = vertices.size() / attribCount;
+    constexpr std::uint32_t unassigned = std::numeric_limits<std::uint32_t>::max();
+
+    std::vector<std::uint32_t> remap(vertexCount, unassigned);
+    std::uint32_t next = 0;
+    for (std::uint32_t& index : indices) {
+        if (index >= vertexCount) {
+            continue;
+        }
+        if (remap[index] == unassigned) {
+            remap[index] = next++;
+        }
+        index = remap[index];
+    }
+    for (std::uint32_t& target : remap) {
+        if (target == unassigned) {
+            target = next++;
+        }
+    }
+
+    std::vector<float> reordered(vertices.size());
+    for (std::size_t v = 0; v < vertexCount; ++v) {
+        std::memcpy(&reordered[std::size_t(remap[v]) * attribCount], &vertices[v * attribCount], attribCount * sizeof(float));
+    }
+    vertices = std::move(reordered);
+}
+
+void optimizeOverdraw(std::span<std::uint32_t> indices, std::span<const float> vertices, float threshold)
+{
+    const std::size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) {
+        return;
+    }
+    const std::size_t vertexCount = referencedCount(indices, vertices.size() / attribCount);
+    constexpr int simulatedCache = 16;
+
+    std::vector<std::size_t> hardBoundaries;
+    {
+        FifoCache cache(vertexCount, simulatedCache);
+        for (std::size_t t = 0; t < triangleCount; ++t) {
+            const int misses = cache.load(indices[3 * t]) + cache.load(indices[3 * t + 1]) + cache.load(indices[3 * t + 2]);
+            if (t == 0 || misses == 3) {
+                hardBoundaries.push_back(t); // nothing reused: the optimiser started a new patch here
+            }
+        }
+        hardBoundaries.push_back(triangleCount);
+    }
+
+    // Split the patches wherever a cold cache would already be back to the patch's
+    // ACMR (times threshold): reordering at those points costs at most that much.
+    std::vector<std::size_t> clusters;
+    {
+        FifoCache cache(vertexCount, simulatedCache);
+        auto loadTriangle = [&](std::size_t t) {
+            return cache.load(indices[3 * t]) + cache.load(indices[3 * t + 1]) + cache.load(indices[3 * t + 2]);
+        };
+        for (std::size_t h = 0; h + 1 < hardBoundaries.size(); ++h) {
+            const std::size_t begin = hardBoundaries[h];
+            const std::size_t end = hardBoundaries[h + 1];
+
+            cache.flush();
+            std::size_t patchMisses = 0;
+            for (std::size_t t = begin; t < end; ++t) {
+                patchMisses += loadTriangle(t);
+            }
+            const float patchThreshold = threshold * float(patchMisses) / float(end - begin);
+
+            cache.flush();
+            clusters.push_back(begin);
+            std::size_t runningMisses = 0;
+            std::size_t runningTriangles = 0;
+            for (std::size_t t = begin; t < end; ++t) {
+                runningMisses += loadTriangle(t);
+                ++runningTriangles;
+                if (t + 1 < end && float(runningMisses) <= patchThreshold * float(runningTriangles)) {
+                    clusters.push_back(t + 1);
+                    runningMisses = 0;
+                    runningTriangles = 0;
+                    cache.flush();
+                }
+            }
+        }
+        clusters.push_back(triangleCount);
+    }
+
+    Vec3 meshCentre{ 0.0f, 0.0f, 0.0f };
+    const std::size_t positionCount = vertices.size() / attribCount;
+    for (std::size_t v = 0; v < positionCount; ++v) {
+        meshCentre = meshCentre + Vec3{ vertices[v * attribCount], vertices[v * attribCount + 1], vertices[v * attribCount + 2] };
+    }
+    meshCentre = meshCentre * (positionCount > 0 ? 1.0f / positionCount : 0.0f);
+
+    // How much each cluster faces away from the centre; those occlude the most and go first.
+    const std::size_t clusterCount = clusters.size() - 1;
+    std::vector<float> outwardness(clusterCount, 0.0f);
+    for (std::size_t c = 0; c < clusterCount; ++c) {
+        Vec3 centroid{ 0.0f, 0.0f, 0.0f };
+        Vec3 normal{ 0.0f, 0.0f, 0.0f };
+        float area = 0.0f;
+        for (std::size_t t = clusters[c]; t < clusters[c + 1]; ++t) {
+            Vec3 p[3];
+            if (!trianglePositions(vertices, &indices[3 * t], p)) {
+                continue;
+            }
+            const Vec3 n = cross(p[1] - p[0], p[2] - p[0]);
+            const float a = length(n);
+            centroid = centroid + (p[0] + p[1] + p[2]) * (a / 3.0f);
+            normal = normal + n;
+            area += a;
+        }
+        const float normalLength = length(normal);
+        if (area > 0.0f && normalLength > 0.0f) {
+            outwardness[c] = dot(centroid * (1.0f / area) - meshCentre, normal * (1.0f / normalLength));
+        }
+    }
+    const float outside = outwardWinding(indices, vertices);
+
+    std::vector<std::size_t> order(clusterCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return outside * outwardness[a] > outside * outwardness[b]; });
+
+    std::vector<std::uint32_t> reordered;
+    reordered.reserve(triangleCount * 3);
+    for (std::size_t c : order) {
+        reordered.insert(reordered.end(), indices.begin() + 3 * clusters[c], indices.begin() + 3 * clusters[c + 1]);
+    }
+    std::copy(reordered.begin(), reordered.end(), indices.begin());
+}
+
+OverdrawStats analyzeOverdraw(std::span<const std::uint32_t> indices, std::span<const float> vertices, bool cullBackFaces, int directions, int resolution)
+{
+    const std::size_t vertexCount = vertices.size() / attribCount;
+    OverdrawStats stats;
+    if (vertexCount == 0 || indices.size() < 3) {
+        return stats;
+    }
+
+    Vec3 low{ std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+    Vec3 high = low * -1.0f;
+    for (std::size_t v = 0; v < vertexCount; ++v) {
+        const float* p = &vertices[v * attribCount];
+        low = { std::min(low.x, p[0]), std::min(low.y, p[1]), std::min(low.z, p[2]) };
+        high = { std::max(high.x, p[0]), std::max(high.y, p[1]), std::max(high.z, p[2]) };
+    }
+    const Vec3 centre = (low + high) * 0.5f;
+    float radius = 0.0f;
+    for (std::size_t v = 0; v < vertexCount; ++v) {
+        const float* p = &vertices[v * attribCount];
+        radius = std::max(radius, length(Vec3{ p[0], p[1], p[2] } - centre));
+    }
+    if (radius == 0.0f) {
+        return stats;
+    }
+
+    // Screen-space signed area is dot(normal, view) and the camera looks along +view, so
+    // outward-wound front faces come out negative and back faces positive.
+    const float outside = outwardWinding(indices, vertices);
+    std::vector<float> depth(std::size_t(resolution) * resolution);
+    for (int d = 0; d < directions; ++d) {
+        // Fibonacci sphere
+        const float z = 1.0f - 2.0f * (d + 0.5f) / directions;
+        const float r = std::sqrt(1.0f - z * z);
+        const float phi = d * std::numbers::pi_v<float> * (3.0f - std::sqrt(5.0f));
+        const Vec3 view{ r * std::cos(phi), r * std::sin(phi), z };
+        const Vec3 up = std::abs(view.z) < 0.9f ? Vec3{ 0.0f, 0.0f, 1.0f } : Vec3{ 1.0f, 0.0f, 0.0f };
+        Vec3 u = cross(up, view);
+        u = u * (1.0f / length(u));
+        const Vec3 w = cross(view, u);
+
+        std::fill(depth.begin(), depth.end(), std::numeric_limits<float>::infinity());
+        const float toPixels = 0.5f * resolution / radius;
+        for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+            Vec3 p[3];
+            if (!trianglePositions(vertices, &indices[i], p)) {
+                continue;
+            }
+            float sx[3], sy[3], sz[3];
+            for (int c = 0; c < 3; ++c) {
+                const Vec3 q = p[c] - centre;
+                sx[c] = dot(q, u) * toPixels + 0.5f * resolution;
+                sy[c] = dot(q, w) * toPixels + 0.5f * resolution;
+                sz[c] = dot(q, view);
+            }
+            const float area = (sx[1] - sx[0]) * (sy[2] - sy[0]) - (sy[1] - sy[0]) * (sx[2] - sx[0]);
+            if (area == 0.0f || (cullBackFaces && area * outside > 0.0f)) {
+                continue;
+            }
+            const float sign = area > 0.0f ? 1.0f : -1.0f;
+            const int x0 = std::max(0, int(std::floor(std::min({ sx[0], sx[1], sx[2] }))));
+            const int x1 = std::min(resolution - 1, int(std::ceil(std::max({ sx[0], sx[1], sx[2] }))));
+            const int y0 = std::max(0, int(std::floor(std::min({ sy[0], sy[1], sy[2] }))));
+            const int y1 = std::min(resolution - 1, int(std::ceil(std::max({ sy[0], sy[1], sy[2] }))));
+            for (int y = y0; y <= y1; ++y) {
+                for (int x = x0; x <= x1; ++x) {
+                    const float px = x + 0.5f;
+                    const float py = y + 0.5f;
+                    const float b0 = sign * ((sx[2] - sx[1]) * (py - sy[1]) - (sy[2] - sy[1]) * (px - sx[1]));
+                    const float b1 = sign * ((sx[0] - sx[2]) * (py - sy[2]) - (sy[0] - sy[2]) * (px - sx[2]));
+                    const float b2 = sign * ((sx[1] - sx[0]) * (py - sy[0]) - (sy[1] - sy[0]) * (px - sx[0]));
+                    if (b0 < 0.0f || b1 < 0.0f || b2 < 0.0f) {
+                        continue;
+                    }
+                    const float fragmentDepth = (b0 * sz[0] + b1 * sz[1] + b2 * sz[2]) / (sign * area);
+                    float& stored = depth[std::size_t(y) * resolution + x];
+                    if (fragmentDepth < stored) {
+                        stored = fragmentDepth;
+                        ++stats.shaded;
+                    }
+                }
+            }
+        }
+        stats.covered += std::count_if(depth.begin(), depth.end(), [](float value) { return value != std::numeric_limits<float>::infinity(); });
+    }
+    stats.overdraw = stats.covered > 0 ? double(stats.shaded) / stats.covered : 0.0;
+    return stats;
+}
+
+MeshOptimizationReport optimizeMesh(std::vector<float>& vertices, std::span<std::uint32_t> indices, float overdrawThreshold)
+{
+    const std::size_t vertexCount = vertices.size() / attribCount;
+    MeshOptimizationReport report;
+    report.before = analyzeVertexCache(indices, vertexCount);
+    optimizeVertexCache(indices, vertexCount);
+    if (overdrawThreshold >= 1.0f) {
+        optimizeOverdraw(indices, vertices, overdrawThreshold);
+    }
+    optimizeVertexFetch(vertices, indices);
+    report.after = analyzeVertexCache(indices, vertexCount);
+    return report;
+}
+
+MeshOptimizationReport optimizeMesh(MeshData& mesh, float overdrawThreshold)
+{
+    if (mesh.primitive != Primitive::Triangles) {
+        return {};
+    }
+    return optimizeMesh(mesh.vertices, mesh.indices, overdrawThreshold);
+}
@@ -0,0 +1,62 @@
+#ifndef MESHOPTIMIZER_H
+#define MESHOPTIMIZER_H
+
+#include "MeshData.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Post-transform cache behaviour of an index buffer, simulated as a FIFO of cacheSize vertices.
+//  acmr: vertices transformed per triangle (0.5 is the limit for a regular grid, 3 is no reuse)
+//  atvr: vertices transformed per referenced vertex (1 is ideal)
+struct VertexCacheStats
+{
+    double acmr{ 0.0 };
+    double atvr{ 0.0 };
+    std::size_t transformed{ 0 };
+};
+
+VertexCacheStats analyzeVertexCache(std::span<const std::uint32_t> indices, std::size_t vertexCount, int cacheSize = 16);
+
+// Reorders triangles for the post-transform cache (Forsyth's scoring, linear in the
+// triangle count). Triangle winding is kept.
+void optimizeVertexCache(std::span<std::uint32_t> indices, std::size_t vertexCount);
+
+// Renumbers MeshData::attribCount-wide interleaved vertices in first-use order so the
+// vertex fetch streams through memory. Unreferenced vertices move to the end.
+void optimizeVertexFetch(std::vector<float>& vertices, std::span<std::uint32_t> indices);
+
+// Reorders cache-optimised triangles to cut overdraw within one draw (Sander et al.,
+// "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw"): the triangle
+// list is cut into clusters wherever the running ACMR is within threshold times the
+// local ACMR, and clusters facing away from the mesh centre are drawn first.
+// threshold 1.05 allows a 5% worse ACMR; 1 keeps only the natural cluster breaks.
+void optimizeOverdraw(std::span<std::uint32_t> indices, std::span<const float> vertices, float threshold = 1.05f);
+
+// Average fragments shaded per covered pixel, rasterized in software from directions spread
+// over the sphere (orthographic, depth tested, in index order). Back faces, found from the
+// mesh's winding, are culled unless cullBackFaces is false.
+struct OverdrawStats
+{
+    double overdraw{ 0.0 };
+    std::size_t covered{ 0 };
+    std::size_t shaded{ 0 };
+};
+
+OverdrawStats analyzeOverdraw(std::span<const std::uint32_t> indices, std::span<const float> vertices,
+    bool cullBackFaces = true, int directions = 16, int resolution = 256);
+
+struct MeshOptimizationReport
+{
+    VertexCacheStats before;
+    VertexCacheStats after;
+};
+
+// Vertex cache, then overdraw (when overdrawThreshold >= 1), then vertex fetch.
+// Only triangle lists are touched.
+MeshOptimizationReport optimizeMesh(std::vector<float>& vertices, std::span<std::uint32_t> indices, float overdrawThreshold = 0.0f);
+MeshOptimizationReport optimizeMesh(MeshData& mesh, float overdrawThreshold = 0.0f);
+
+#endif // MESHOPTIMIZER_H
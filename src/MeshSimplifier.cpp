@@ -0,0 +1,592 @@
+#include "MeshSimplifier.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr int attribCount = MeshData::attribCount;
+    constexpr int texOffset = 6;
+    constexpr int normalOffset = 8;
+    constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+
+    // Sum of squared distances to a set of planes, each weighted by its triangle's area.
+    struct Quadric
+    {
+        double xx{ 0 }, xy{ 0 }, xz{ 0 }, xw{ 0 }, yy{ 0 }, yz{ 0 }, yw{ 0 }, zz{ 0 }, zw{ 0 }, ww{ 0 };
+        double area{ 0 };
+
+        void addPlane(double a, double b, double c, double d, double weight)
+        {
+            xx += weight * a * a; xy += weight * a * b; xz += weight * a * c; xw += weight * a * d;
+            yy += weight * b * b; yz += weight * b * c; yw += weight * b * d;
+            zz += weight * c * c; zw += weight * c * d;
+            ww += weight * d * d;
+            area += weight;
+        }
+
+        Quadric& operator+=(const Quadric& other)
+        {
+            xx += other.xx; xy += other.xy; xz += other.xz; xw += other.xw;
+            yy += other.yy; yz += other.yz; yw += other.yw;
+            zz += other.zz; zw += other.zw;
+            ww += other.ww;
+            area += other.area;
+            return *this;
+        }
+
+        // Area-weighted sum of squared distances from p to the planes.
+        double evaluate(const float* p) const
+        {
+            const double x = p[0], y = p[1], z = p[2];
+            return xx * x * x + yy * y * y + zz * z * z + ww
+                + 2.0 * (xy * x * y + xz * x * z + yz * y * z + xw * x + yw * y + zw * z);
+        }
+    };
+
+    // Squared weights of the attribute terms, in object-space units.
+    struct Weights
+    {
+        double normal;
+        double texCoord;
+    };
+
+    struct Candidate
+    {
+        float cost;
+        std::uint32_t from, to;
+
+        bool operator<(const Candidate& other) const { return cost < other.cost; }
+    };
+
+    std::array<float, 3> triangleNormal(const float* a, const float* b, const float* c)
+    {
+        const float u[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+        const float v[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+        return { u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0] };
+    }
+
+    float dot(const std::array<float, 3>& a, const std::array<float, 3>& b)
+    {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+
+    // Collapses the edges of one set of triangles. Vertices are renumbered locally so that
+    // slabs of a large mesh only pay for the vertices they use. Quadrics are built from the
+    // triangles' planes unless given (indexed like vertices), as when carried over from slabs.
+    class EdgeCollapser
+    {
+    public:
+        EdgeCollapser(std::span<const float> vertices, std::span<const std::uint32_t> triangles,
+            const std::vector<std::uint8_t>* frozen, const Weights& weights, unsigned threads,
+            const std::vector<Quadric>* quadrics = nullptr)
+            : m_vertices(vertices.data())
+            , m_weights(weights)
+            , m_threads(threads)
+        {
+            std::vector<std::uint32_t> local(vertices.size() / attribCount, none);
+            m_triangles.reserve(triangles.size());
+            for (std::size_t i = 0; i + 2 < triangles.size(); i += 3) {
+                const std::uint32_t* t = &triangles[i];
+                if (t[0] == t[1] || t[1] == t[2] || t[0] == t[2]) {
+                    continue;
+                }
+                for (int c = 0; c < 3; ++c) {
+                    if (local[t[c]] == none) {
+                        local[t[c]] = std::uint32_t(m_global.size());
+                        m_global.push_back(t[c]);
+                    }
+                    m_triangles.push_back(local[t[c]]);
+                }
+            }
+            const std::size_t vertexCount = m_global.size();
+            const std::size_t triangleCount = m_triangles.size() / 3;
+            m_live = triangleCount;
+            m_triangleAlive.assign(triangleCount, 1);
+            m_vertexAlive.assign(vertexCount, 1);
+            m_touched.assign(vertexCount, 0);
+            m_best.assign(vertexCount, { 0.0f, 0, none });
+            m_dirty.assign(vertexCount, 1);
+            m_mark.assign(vertexCount, 0);
+            m_locked.assign(vertexCount, 0);
+            m_quadrics.resize(vertexCount);
+            m_vertexTriangles.resize(vertexCount);
+
+            std::vector<std::uint32_t> valence(vertexCount, 0);
+            for (std::uint32_t v : m_triangles) {
+                ++valence[v];
+            }
+            for (std::size_t v = 0; v < vertexCount; ++v) {
+                m_vertexTriangles[v].reserve(valence[v]);
+                m_locked[v] = frozen && (*frozen)[m_global[v]];
+                if (quadrics) {
+                    m_quadrics[v] = (*quadrics)[m_global[v]];
+                }
+            }
+
+            for (std::uint32_t t = 0; t < triangleCount; ++t) {
+                const std::uint32_t* corners = &m_triangles[std::size_t(t) * 3];
+                const std::array<float, 3> n = triangleNormal(position(corners[0]), position(corners[1]), position(corners[2]));
+                const double length = std::sqrt(double(n[0]) * n[0] + double(n[1]) * n[1] + double(n[2]) * n[2]);
+                for (int c = 0; c < 3; ++c) {
+                    m_vertexTriangles[corners[c]].push_back(t);
+                }
+                if (quadrics || length <= 0.0) {
+                    continue;
+                }
+                const double a = n[0] / length, b = n[1] / length, c = n[2] / length;
+                const float* p = position(corners[0]);
+                const double d = -(a * p[0] + b * p[1] + c * p[2]);
+                for (int corner = 0; corner < 3; ++corner) {
+                    m_quadrics[corners[corner]].addPlane(a, b, c, d, 0.5 * length);
+                }
+            }
+
+            lockBoundaries();
+        }
+
+        // Collapses the cheapest edges until at most target triangles are left or every
+        // collapse would cost more than maxError. Returns the largest cost collapsed.
+        //
+        // Rather than keeping a priority queue up to date, each pass finds the cheapest collapse
+        // out of every vertex, sorts them and applies them in order, skipping those whose ends
+        // an earlier collapse of the pass has changed. That keeps the memory access linear and
+        // lets the costs be evaluated in parallel. A pass stops a little past the cost that would
+        // reach the target if nothing were skipped, so cheap collapses still go first.
+        float run(std::size_t target, float maxError)
+        {
+            float reached = 0.0f;
+            std::vector<Candidate> candidates;
+            for (std::uint32_t pass = 1; m_live > target; ++pass) {
+                cheapestCollapses(candidates);
+                std::sort(candidates.begin(), candidates.end());
+                const std::size_t goal = (m_live - target) / 2; // each collapse removes about two triangles
+                const float limit = goal < candidates.size() ? std::min(maxError, 1.5f * candidates[goal].cost) : maxError;
+
+                std::size_t collapsed = 0;
+                for (const Candidate& candidate : candidates) {
+                    if (candidate.cost > limit || m_live <= target) {
+                        break;
+                    }
+                    if (m_touched[candidate.from] == pass || m_touched[candidate.to] == pass
+                        || !collapse(candidate.from, candidate.to)) {
+                        continue;
+                    }
+                    m_touched[candidate.from] = pass;
+                    m_touched[candidate.to] = pass;
+                    reached = std::max(reached, candidate.cost);
+                    ++collapsed;
+                }
+                if (collapsed == 0) {
+                    break;
+                }
+            }
+            return reached;
+        }
+
+        // Adds the quadric of every vertex still in use to quadrics, indexed like vertices.
+        // Vertices shared with other slabs sum the planes of each slab's triangles.
+        void addQuadrics(std::vector<Quadric>& quadrics) const
+        {
+            for (std::size_t v = 0; v < m_global.size(); ++v) {
+                if (m_vertexAlive[v]) {
+                    quadrics[m_global[v]] += m_quadrics[v];
+                }
+            }
+        }
+
+        void appendTriangles(std::vector<std::uint32_t>& out) const
+        {
+            for (std::size_t t = 0; t < m_triangleAlive.size(); ++t) {
+                if (m_triangleAlive[t]) {
+                    for (int c = 0; c < 3; ++c) {
+                        out.push_back(m_global[m_triangles[t * 3 + c]]);
+                    }
+                }
+            }
+        }
+
+    private:
+        const float* attributes(std::uint32_t v) const { return m_vertices + std::size_t(m_global[v]) * attribCount; }
+        const float* position(std::uint32_t v) const { return attributes(v); }
+
+        // Calls fn once for every vertex sharing a live triangle with v. Leaves them (and v)
+        // marked with the returned value.
+        template<typename Fn>
+        std::uint32_t forEachNeighbour(std::uint32_t v, Fn&& fn)
+        {
+            const std::uint32_t mark = nextMark();
+            m_mark[v] = mark;
+            for (std::uint32_t t : m_vertexTriangles[v]) {
+                if (!m_triangleAlive[t]) {
+                    continue;
+                }
+                for (int c = 0; c < 3; ++c) {
+                    const std::uint32_t other = m_triangles[std::size_t(t) * 3 + c];
+                    if (m_mark[other] != mark) {
+                        m_mark[other] = mark;
+                        fn(other);
+                    }
+                }
+            }
+            return mark;
+        }
+
+        std::uint32_t nextMark()
+        {
+            if (++m_markValue == 0) {
+                std::fill(m_mark.begin(), m_mark.end(), 0);
+                m_markValue = 1;
+            }
+            return m_markValue;
+        }
+
+        // Every edge of a closed manifold is shared by exactly two triangles. Ends of edges
+        // that are not (open boundaries, seams, non-manifold fins) stay where they are.
+        void lockBoundaries()
+        {
+            std::vector<std::uint32_t> shared(m_global.size(), 0);
+            std::vector<std::uint32_t> neighbours;
+            for (std::uint32_t v = 0; v < m_global.size(); ++v) {
+                neighbours.clear();
+                for (std::uint32_t t : m_vertexTriangles[v]) {
+                    for (int c = 0; c < 3; ++c) {
+                        const std::uint32_t other = m_triangles[std::size_t(t) * 3 + c];
+                        if (other != v && shared[other]++ == 0) {
+                            neighbours.push_back(other);
+                        }
+                    }
+                }
+                for (std::uint32_t other : neighbours) {
+                    if (shared[other] != 2) {
+                        m_locked[v] = 1;
+                        m_locked[other] = 1;
+                    }
+                    shared[other] = 0;
+                }
+            }
+        }
+
+        // Squared cost of merging from into to: the mean squared distance of to from the planes
+        // of both, plus the attribute terms.
+        double cost(std::uint32_t from, std::uint32_t to) const
+        {
+            const Quadric& q0 = m_quadrics[from];
+            const Quadric& q1 = m_quadrics[to];
+            const float* a = attributes(from);
+            const float* b = attributes(to);
+            double normal = 0.0, texCoord = 0.0;
+            for (int c = 0; c < 3; ++c) {
+                normal += double(a[normalOffset + c] - b[normalOffset + c]) * (a[normalOffset + c] - b[normalOffset + c]);
+            }
+            for (int c = 0; c < 2; ++c) {
+                texCoord += double(a[texOffset + c] - b[texOffset + c]) * (a[texOffset + c] - b[texOffset + c]);
+            }
+            const double area = q0.area + q1.area;
+            const double distance = area > 0.0 ? std::max(0.0, (q0.evaluate(b) + q1.evaluate(b)) / area) : 0.0;
+            return distance + m_weights.normal * normal + m_weights.texCoord * texCoord;
+        }
+
+        // The cheapest collapse out of every vertex that may move. Only vertices next to an
+        // earlier collapse are looked at again; each drops the triangles collapses have removed
+        // from its list, which nothing else touches meanwhile.
+        void cheapestCollapses(std::vector<Candidate>& candidates)
+        {
+            ThreadPool::shared().parallelFor(m_global.size(), 4096, m_threads, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t v = begin; v < end; ++v) {
+                    if (!m_dirty[v] || !m_vertexAlive[v] || m_locked[v]) {
+                        continue;
+                    }
+                    m_dirty[v] = 0;
+                    double bestCost = std::numeric_limits<double>::max();
+                    std::uint32_t best = none;
+                    compact(m_vertexTriangles[v]);
+                    for (std::uint32_t t : m_vertexTriangles[v]) {
+                        for (int c = 0; c < 3; ++c) {
+                            const std::uint32_t other = m_triangles[std::size_t(t) * 3 + c];
+                            if (other != v) {
+                                const double candidate = cost(std::uint32_t(v), other);
+                                if (candidate < bestCost) {
+                                    bestCost = candidate;
+                                    best = other;
+                                }
+                            }
+                        }
+                    }
+                    m_best[v] = { float(std::sqrt(bestCost)), std::uint32_t(v), best };
+                }
+            });
+
+            candidates.clear();
+            for (std::size_t v = 0; v < m_global.size(); ++v) {
+                if (m_vertexAlive[v] && !m_locked[v] && m_best[v].to != none) {
+                    candidates.push_back(m_best[v]);
+                }
+            }
+        }
+
+        void compact(std::vector<std::uint32_t>& triangles)
+        {
+            std::erase_if(triangles, [&](std::uint32_t t) { return !m_triangleAlive[t]; });
+        }
+
+        bool contains(std::uint32_t t, std::uint32_t v) const
+        {
+            const std::uint32_t* corners = &m_triangles[std::size_t(t) * 3];
+            return corners[0] == v || corners[1] == v || corners[2] == v;
+        }
+
+        // Merges from into to, unless that would pinch the surface or fold a triangle over.
+        bool collapse(std::uint32_t from, std::uint32_t to)
+        {
+            std::vector<std::uint32_t>& fromTriangles = m_vertexTriangles[from];
+            std::vector<std::uint32_t>& toTriangles = m_vertexTriangles[to];
+            compact(fromTriangles);
+
+            std::size_t sharedTriangles = 0;
+            for (std::uint32_t t : fromTriangles) {
+                sharedTriangles += contains(t, to);
+            }
+            if (sharedTriangles == 0) {
+                return false;
+            }
+
+            // link condition: the ends may only share the neighbours opposite the edge
+            const std::uint32_t toMark = forEachNeighbour(to, [](std::uint32_t) {});
+            m_scratch.clear();
+            for (std::uint32_t t : fromTriangles) {
+                for (int c = 0; c < 3; ++c) {
+                    const std::uint32_t other = m_triangles[std::size_t(t) * 3 + c];
+                    if (other != from && other != to && m_mark[other] == toMark) {
+                        m_scratch.push_back(other);
+                    }
+                }
+            }
+            std::sort(m_scratch.begin(), m_scratch.end());
+            const std::size_t sharedNeighbours = std::unique(m_scratch.begin(), m_scratch.end()) - m_scratch.begin();
+            if (sharedNeighbours != sharedTriangles) {
+                return false;
+            }
+
+            const float* target = position(to);
+            for (std::uint32_t t : fromTriangles) {
+                if (contains(t, to)) {
+                    continue;
+                }
+                const std::uint32_t* corners = &m_triangles[std::size_t(t) * 3];
+                const float* p[3];
+                const float* moved[3];
+                for (int c = 0; c < 3; ++c) {
+                    p[c] = position(corners[c]);
+                    moved[c] = corners[c] == from ? target : p[c];
+                }
+                const std::array<float, 3> before = triangleNormal(p[0], p[1], p[2]);
+                const std::array<float, 3> after = triangleNormal(moved[0], moved[1], moved[2]);
+                // reject flips and anything that turns the triangle by more than ~75 degrees
+                if (dot(before, after) <= 0.25f * std::sqrt(dot(before, before) * dot(after, after))) {
+                    return false;
+                }
+            }
+
+            for (std::uint32_t t : fromTriangles) {
+                if (contains(t, to)) {
+                    m_triangleAlive[t] = 0;
+                    --m_live;
+                    continue;
+                }
+                std::uint32_t* corners = &m_triangles[std::size_t(t) * 3];
+                for (int c = 0; c < 3; ++c) {
+                    if (corners[c] == from) {
+                        corners[c] = to;
+                    }
+                }
+                toTriangles.push_back(t);
+            }
+            std::vector<std::uint32_t>().swap(fromTriangles);
+            compact(toTriangles);
+
+            m_quadrics[to] += m_quadrics[from];
+            m_vertexAlive[from] = 0;
+            m_dirty[to] = 1;
+            forEachNeighbour(to, [&](std::uint32_t neighbour) { m_dirty[neighbour] = 1; });
+            return true;
+        }
+
+        const float* m_vertices;
+        Weights m_weights;
+        unsigned m_threads;
+        std::vector<std::uint32_t> m_global;
+        std::vector<std::uint32_t> m_triangles;
+        std::vector<std::uint8_t> m_triangleAlive;
+        std::vector<std::uint8_t> m_vertexAlive;
+        std::vector<std::uint8_t> m_locked;
+        std::vector<std::uint32_t> m_touched; // the last pass that changed each vertex
+        std::vector<Candidate> m_best;
+        std::vector<std::uint8_t> m_dirty; // m_best needs working out again
+        std::vector<std::uint32_t> m_mark;
+        std::uint32_t m_markValue{ 0 };
+        std::vector<Quadric> m_quadrics;
+        std::vector<std::vector<std::uint32_t>> m_vertexTriangles;
+        std::vector<std::uint32_t> m_scratch;
+        std::size_t m_live{ 0 };
+    };
+
+    // Splits triangles into count slabs of equal size along the longest axis of the bounds.
+    std::vector<std::vector<std::uint32_t>> slabTriangles(std::span<const float> vertices,
+        std::span<const std::uint32_t> indices, int axis, std::size_t count)
+    {
+        const std::size_t triangleCount = indices.size() / 3;
+        std::vector<float> keys(triangleCount);
+        for (std::size_t t = 0; t < triangleCount; ++t) {
+            keys[t] = vertices[std::size_t(indices[t * 3]) * attribCount + axis]
+                + vertices[std::size_t(indices[t * 3 + 1]) * attribCount + axis]
+                + vertices[std::size_t(indices[t * 3 + 2]) * attribCount + axis];
+        }
+        std::vector<float> sorted = keys;
+        std::vector<float> bounds;
+        for (std::size_t slab = 1; slab < count; ++slab) {
+            auto nth = sorted.begin() + slab * triangleCount / count;
+            std::nth_element(sorted.begin(), nth, sorted.end());
+            bounds.push_back(*nth);
+        }
+        std::sort(bounds.begin(), bounds.end());
+
+        std::vector<std::vector<std::uint32_t>> slabs(count);
+        for (auto& slab : slabs) {
+            slab.reserve(indices.size() / count + 3);
+        }
+        for (std::size_t t = 0; t < triangleCount; ++t) {
+            const std::size_t slab = std::upper_bound(bounds.begin(), bounds.end(), keys[t]) - bounds.begin();
+            slabs[slab].insert(slabs[slab].end(), &indices[t * 3], &indices[t * 3] + 3);
+        }
+        return slabs;
+    }
+}
+
+SimplifyResult simplifyIndices(std::span<const float> vertices, std::span<const std::uint32_t> indices,
+    const SimplifyOptions& options)
+{
+    SimplifyResult result;
+    const std::size_t vertexCount = vertices.size() / attribCount;
+    const std::size_t triangleCount = indices.size() / 3;
+    for (std::size_t i = 0; i < triangleCount * 3; ++i) {
+        if (indices[i] >= vertexCount) {
+            return { std::vector<std::uint32_t>(indices.begin(), indices.end()), 0.0f }; // not a triangle list of these vertices
+        }
+    }
+
+    std::array<float, 3> low, high;
+    low.fill(std::numeric_limits<float>::max());
+    high.fill(std::numeric_limits<float>::lowest());
+    for (std::size_t v = 0; v < vertexCount; ++v) {
+        for (int c = 0; c < 3; ++c) {
+            low[c] = std::min(low[c], vertices[v * attribCount + c]);
+            high[c] = std::max(high[c], vertices[v * attribCount + c]);
+        }
+    }
+    int axis = 0;
+    float radius = 0.0f;
+    for (int c = 0; c < 3; ++c) {
+        const float extent = vertexCount ? high[c] - low[c] : 0.0f;
+        axis = extent > high[axis] - low[axis] ? c : axis;
+        radius += 0.25f * extent * extent;
+    }
+    radius = std::sqrt(radius);
+    const Weights weights{ double(options.normalWeight) * options.normalWeight * radius * radius,
+        double(options.texCoordWeight) * options.texCoordWeight * radius * radius };
+
+    const unsigned threads = options.threads == 0 ? std::thread::hardware_concurrency() : options.threads;
+    const std::size_t slabCount = std::min<std::size_t>(threads, triangleCount / std::max<std::size_t>(options.minTrianglesPerSlab, 1));
+
+    std::vector<std::uint32_t> current;
+    std::vector<Quadric> quadrics;
+    float slabError = 0.0f;
+    if (slabCount <= 1) {
+        current.assign(indices.begin(), indices.begin() + triangleCount * 3);
+    } else {
+        // Slabs collapse in parallel with the vertices they share frozen, stopping at twice
+        // their share of the target (and four triangles per seam vertex) or half the error,
+        // so that the final pass below has room to finish the seams. That pass carries on from
+        // the slabs' quadrics, so its costs still measure the error against the original.
+        const std::vector<std::vector<std::uint32_t>> slabs = slabTriangles(vertices, indices, axis, slabCount);
+        std::vector<std::uint8_t> frozen(vertexCount, 0);
+        std::vector<std::uint32_t> owner(vertexCount, none);
+        for (std::size_t slab = 0; slab < slabCount; ++slab) {
+            for (std::uint32_t v : slabs[slab]) {
+                if (owner[v] == none) {
+                    owner[v] = std::uint32_t(slab);
+                } else if (owner[v] != slab) {
+                    frozen[v] = 1;
+                }
+            }
+        }
+
+        std::vector<std::unique_ptr<EdgeCollapser>> collapsers(slabCount);
+        std::vector<float> errors(slabCount, 0.0f);
+        ThreadPool::shared().parallelFor(slabCount, 1, threads, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t slab = begin; slab < end; ++slab) {
+                std::vector<std::uint32_t> used(slabs[slab]);
+                std::sort(used.begin(), used.end());
+                used.erase(std::unique(used.begin(), used.end()), used.end());
+                std::size_t seam = 0;
+                for (std::uint32_t v : used) {
+                    seam += frozen[v];
+                }
+                const std::size_t target = std::max(2 * options.targetTriangles * (slabs[slab].size() / 3) / triangleCount, 4 * seam);
+                collapsers[slab] = std::make_unique<EdgeCollapser>(vertices, slabs[slab], &frozen, weights, 1);
+                errors[slab] = collapsers[slab]->run(target, 0.5f * options.maxError);
+            }
+        });
+        quadrics.resize(vertexCount);
+        for (std::size_t slab = 0; slab < slabCount; ++slab) {
+            collapsers[slab]->appendTriangles(current);
+            collapsers[slab]->addQuadrics(quadrics);
+            collapsers[slab].reset();
+            slabError = std::max(slabError, errors[slab]);
+        }
+    }
+
+    EdgeCollapser collapser(vertices, current, nullptr, weights, threads, quadrics.empty() ? nullptr : &quadrics);
+    result.error = std::max(slabError, collapser.run(options.targetTriangles, options.maxError));
+    result.indices.reserve(current.size());
+    collapser.appendTriangles(result.indices);
+    return result;
+}
+
+float simplifyMesh(MeshData& mesh, const SimplifyOptions& options)
+{
+    if (mesh.primitive != Primitive::Triangles || mesh.indices.empty()) {
+        return 0.0f;
+    }
+    SimplifyResult result = simplifyIndices(mesh.vertices, mesh.indices, options);
+    mesh.indices = std::move(result.indices);
+
+    const std::size_t vertexCount = mesh.vertexCount();
+    std::vector<std::uint32_t> compacted(vertexCount, none);
+    for (unsigned int index : mesh.indices) {
+        compacted[index] = 0;
+    }
+    std::size_t kept = 0;
+    for (std::size_t v = 0; v < vertexCount; ++v) {
+        if (compacted[v] == none) {
+            continue;
+        }
+        if (kept != v) {
+            std::memcpy(&mesh.vertices[kept * attribCount], &mesh.vertices[v * attribCount], attribCount * sizeof(float));
+        }
+        compacted[v] = std::uint32_t(kept++);
+    }
+    for (unsigned int& index : mesh.indices) {
+        index = compacted[index];
+    }
+    mesh.vertices.resize(kept * attribCount);
+    mesh.vertices.shrink_to_fit();
+    mesh.indices.shrink_to_fit();
+    return result.error;
+}
@@ -0,0 +1,51 @@
+#ifndef MESHSIMPLIFIER_H
+#define MESHSIMPLIFIER_H
+
+#include "MeshData.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+// When to stop collapsing edges, and what a collapse costs.
+//  targetTriangles: stop once this few triangles remain (0: collapse as far as maxError allows)
+//  maxError: largest error of a collapse, in object-space units: the area-weighted RMS
+//      distance of the kept vertex from the planes of the triangles merged into it, plus the
+//      attribute terms. It is not a bound on the distance between the surfaces, which can
+//      be two or three times larger.
+//  normalWeight, texCoordWeight: how much a unit change of normal or texture coordinate weighs,
+//      as a fraction of the mesh's radius, against moving the surface
+//  threads: large meshes are cut into slabs that are simplified in parallel before the whole is
+//      finished in one pass, which gives close to the serial result
+struct SimplifyOptions
+{
+    std::size_t targetTriangles{ 0 };
+    float maxError{ std::numeric_limits<float>::max() };
+    float normalWeight{ 0.02f };
+    float texCoordWeight{ 0.02f };
+    unsigned threads{ 1 };                      // 1 == serial, 0 == one per hardware thread
+    std::size_t minTrianglesPerSlab{ 32768 };
+};
+
+struct SimplifyResult
+{
+    std::vector<std::uint32_t> indices;
+    float error{ 0.0f }; // the largest collapse error (RMS, in the units of maxError)
+};
+
+// Garland-Heckbert quadric error simplification of an 11-float triangle list by half-edge
+// collapses: a vertex merges into a neighbour, so no new vertices or attributes are made and
+// the result indexes the same vertex buffer. The error of a collapse is the distance to the
+// planes of the merged triangles plus the weighted change of normal and texture coordinate.
+// Vertices on open boundaries, on seams (split vertices) and on non-manifold edges never move,
+// and collapses that would flip a triangle or pinch the surface are skipped.
+SimplifyResult simplifyIndices(std::span<const float> vertices, std::span<const std::uint32_t> indices,
+    const SimplifyOptions& options = {});
+
+// simplifyIndices() on a triangle list, then drops the vertices nothing references any more.
+// Returns the error.
+float simplifyMesh(MeshData& mesh, const SimplifyOptions& options = {});
+
+#endif // MESHSIMPLIFIER_H
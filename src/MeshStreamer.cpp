@@ -0,0 +1,77 @@
+#include "MeshStreamer.hpp"
+
+#include <chrono>
+#include <utility>
+
+bool StreamedMesh::ready() const
+{
+    return m_mesh != nullptr;
+}
+
+void StreamedMesh::draw()
+{
+    if (m_mesh) {
+        m_mesh->draw();
+    }
+    else if (m_placeholder) {
+        m_placeholder->draw();
+    }
+}
+
+std::shared_ptr<ShapeMesh> StreamedMesh::mesh() const
+{
+    return m_mesh;
+}
+
+MeshStreamer::MeshStreamer(ThreadPool& pool)
+    : m_pool(pool)
+    , m_shared(std::make_shared<Shared>())
+{
+}
+
+std::shared_ptr<StreamedMesh> MeshStreamer::request(std::function<MeshData()> generator, std::shared_ptr<ShapeMesh> placeholder)
+{
+    auto handle = std::make_shared<StreamedMesh>();
+    handle->m_placeholder = std::move(placeholder);
+
+    m_shared->inFlight.fetch_add(1);
+    m_pool.submit([shared = m_shared, target = std::weak_ptr<StreamedMesh>(handle), generator = std::move(generator)] {
+        if (target.expired()) {
+            shared->queue.push({ target, {} }); // still pushed so the in-flight count settles on the GL thread
+            return;
+        }
+        shared->queue.push({ target, generator() });
+    });
+    return handle;
+}
+
+std::size_t MeshStreamer::pump(double budgetMs)
+{
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t uploaded = 0;
+
+    for (;;) {
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if (uploaded > 0 && elapsed.count() >= budgetMs) {
+            break;
+        }
+
+        auto finished = m_shared->queue.pop();
+        if (!finished) {
+            break;
+        }
+        m_shared->inFlight.fetch_sub(1);
+
+        if (auto target = finished->target.lock()) {
+            target->m_mesh = std::make_shared<ShapeMesh>(std::move(finished->data));
+            target->m_placeholder.reset();
+            ++uploaded;
+        }
+    }
+    return uploaded;
+}
+
+std::size_t MeshStreamer::inFlight() const
+{
+    return m_shared->inFlight.load();
+}
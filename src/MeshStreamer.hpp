@@ -0,0 +1,70 @@
+#ifndef MESHSTREAMER_H
+#define MESHSTREAMER_H
+
+#include "ShapeMesh.hpp"
+#include "MpscQueue.hpp"
+#include "ThreadPool.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+// Handle to a mesh being generated in the background. Until its data has been
+// uploaded, draw() falls back to the placeholder (if any) or draws nothing.
+class StreamedMesh
+{
+public:
+    bool ready() const;
+    void draw();
+
+    std::shared_ptr<ShapeMesh> mesh() const; // null until ready()
+
+private:
+    friend class MeshStreamer;
+
+    std::shared_ptr<ShapeMesh> m_mesh;
+    std::shared_ptr<ShapeMesh> m_placeholder;
+};
+
+// Runs MeshData generation on a worker pool and uploads the results on the GL
+// thread. Workers push finished data to a lock-free queue; pump() drains it once
+// per frame, stopping when the frame's upload budget is spent.
+class MeshStreamer
+{
+public:
+    explicit MeshStreamer(ThreadPool& pool = ThreadPool::shared());
+
+    std::shared_ptr<StreamedMesh> request(std::function<MeshData()> generator,
+        std::shared_ptr<ShapeMesh> placeholder = nullptr);
+
+    // GL thread only. Uploads at least one finished mesh if any are waiting, then
+    // keeps going until budgetMs has elapsed. Returns the number uploaded.
+    std::size_t pump(double budgetMs);
+
+    std::size_t inFlight() const; // requested but not yet uploaded
+
+    MeshStreamer(const MeshStreamer& other) = delete;
+    MeshStreamer& operator=(const MeshStreamer& other) = delete;
+    MeshStreamer(MeshStreamer&& other) = delete;
+    MeshStreamer& operator=(MeshStreamer&& other) = delete;
+
+private:
+    struct Finished
+    {
+        std::weak_ptr<StreamedMesh> target;
+        MeshData data;
+    };
+
+    // Shared with worker tasks so the streamer can go away while they still run.
+    struct Shared
+    {
+        MpscQueue<Finished> queue;
+        std::atomic<std::size_t> inFlight{ 0 };
+    };
+
+    ThreadPool& m_pool;
+    std::shared_ptr<Shared> m_shared;
+};
+
+#endif // MESHSTREAMER_H
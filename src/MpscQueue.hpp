@@ -0,0 +1,66 @@
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+// Unbounded lock-free multi-producer single-consumer queue (Vyukov). push() may be
+// called from any thread; pop() from one consumer thread only.
+template <typename T>
+class MpscQueue
+{
+public:
+    MpscQueue()
+        : m_head(new Node)
+        , m_tail(m_head.load())
+    {
+    }
+
+    ~MpscQueue()
+    {
+        while (m_tail) {
+            Node* next = m_tail->next.load(std::memory_order_relaxed);
+            delete m_tail;
+            m_tail = next;
+        }
+    }
+
+    void push(T value)
+    {
+        Node* node = new Node;
+        node->value.emplace(std::move(value));
+        Node* previous = m_head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    std::optional<T> pop()
+    {
+        Node* next = m_tail->next.load(std::memory_order_acquire);
+        if (!next) {
+            return std::nullopt;
+        }
+        std::optional<T> value = std::move(next->value);
+        next->value.reset();
+        delete m_tail;
+        m_tail = next;
+        return value;
+    }
+
+    MpscQueue(const MpscQueue& other) = delete;
+    MpscQueue& operator=(const MpscQueue& other) = delete;
+    MpscQueue(MpscQueue&& other) = delete;
+    MpscQueue& operator=(MpscQueue&& other) = delete;
+
+private:
+    struct Node
+    {
+        std::atomic<Node*> next{ nullptr };
+        std::optional<T> value;
+    };
+
+    std::atomic<Node*> m_head; // producers
+    Node* m_tail;              // consumer, always a node whose value was already taken
+};
+
+#endif // MPSCQUEUE_H
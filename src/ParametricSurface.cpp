@@ -0,0 +1,68 @@
+#include "ParametricSurface.hpp"
+#include "ThreadPool.hpp"
+
+#include <thread>
+
+void forEachGridRow(int rows, int rowSize, const GenerateOptions& options, const std::function<void(int, int)>& fn)
+{
+    const unsigned threads = options.threads == 0 ? std::thread::hardware_concurrency() : options.threads;
+    if (threads <= 1 || static_cast<std::size_t>(rows) * rowSize < options.minVerticesPerTask * 2) {
+        fn(0, rows);
+        return;
+    }
+
+    const std::size_t grain = std::max<std::size_t>(1, options.minVerticesPerTask / std::max(1, rowSize));
+    ThreadPool::shared().parallelFor(rows, grain, threads, [&](std::size_t begin, std::size_t end) {
+        fn(static_cast<int>(begin), static_cast<int>(end));
+    });
+}
+
+void emitGridIndices(MeshData& mesh, const SurfaceGrid& grid, const GenerateOptions& options)
+{
+    const int n = grid.columns;
+    const int rows = grid.closedRows ? grid.rows : grid.rows - 1; // rows of quads
+    auto above = [&](int j) -> unsigned int { return (grid.closedRows && j + 1 == rows ? 0 : j + 1) * n; };
+
+    if (options.triangleStrips) {
+        // one strip per row, wrapping around its ring; winding matches the lists
+        const int rowLength = 2 * (n + 1) + 1; // + the restart
+        mesh.primitive = Primitive::TriangleStrip;
+        mesh.indices.resize(static_cast<std::size_t>(rowLength) * rows - 1);
+        forEachGridRow(rows, n, options, [&](int rowBegin, int rowEnd) {
+            for (int j = rowBegin; j < rowEnd; ++j) {
+                const unsigned int bottom = j * n;
+                const unsigned int top = above(j);
+                unsigned int* out = &mesh.indices[static_cast<std::size_t>(j) * rowLength];
+                for (int i = 0; i <= n; ++i) {
+                    *out++ = top + i % n;
+                    *out++ = bottom + i % n;
+                }
+                if (j + 1 < rows) {
+                    *out = MeshData::restartIndex;
+                }
+            }
+        });
+        return;
+    }
+
+    // every row writes 6n indices, so row j starts at 6nj
+    mesh.primitive = Primitive::Triangles;
+    mesh.indices.resize(static_cast<std::size_t>(6) * n * rows);
+    forEachGridRow(rows, n, options, [&](int rowBegin, int rowEnd) {
+        for (int j = rowBegin; j < rowEnd; ++j) {
+            const unsigned int bottom = j * n;
+            const unsigned int top = above(j);
+            unsigned int* out = &mesh.indices[static_cast<std::size_t>(6) * n * j];
+            for (int i = 0; i < n; ++i, out += 6) {
+                const unsigned int next = i + 1 < n ? i + 1 : 0;
+                out[0] = top + i;
+                out[1] = bottom + i;
+                out[2] = top + next;
+
+                out[3] = bottom + i;
+                out[4] = bottom + next;
+                out[5] = top + next;
+            }
+        }
+    });
+}
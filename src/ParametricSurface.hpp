@@ -0,0 +1,142 @@
+#ifndef PARAMETRICSURFACE_H
+#define PARAMETRICSURFACE_H
+
+#include "MeshData.hpp"
+#include "MeshGenerators.hpp"
+#include "RingKernel.hpp"
+#include "VertexRandom.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+// Grid shapes as a surface functor plus one shared generator. A surface is any callable
+// taking a SurfacePoint and returning a SurfaceSample; generateParametricSurface() is
+// compiled per surface, so the functor inlines into its vertex loop.
+
+// The grid a surface is sampled on. Columns wrap around u with no seam column. Open grids
+// run rows from v = 0 to 1 inclusive (pole to pole); closed grids wrap the last row onto
+// the first.
+struct SurfaceGrid
+{
+    int columns;
+    int rows;
+    bool closedRows;
+    int columnStep{ 1 }; // column i takes the angle of column (i * columnStep) mod columns
+};
+
+struct SurfacePoint
+{
+    float u;          // column / columns
+    float v;          // row / (rows - 1) when open, row / rows when closed
+    float cosU, sinU; // of the column's angle, 2pi u (for columnStep 1)
+    float cosV, sinV; // of pi v when open, 2pi v when closed
+};
+
+struct SurfaceSample
+{
+    float position[3];
+    float normal[3];
+    float texCoord[2];
+};
+
+// Runs fn(rowBegin, rowEnd) over a grid of rows, each rowSize vertices wide, on
+// ThreadPool::shared() as options allow. Rows are handed out in contiguous blocks so each
+// task writes a disjoint range.
+void forEachGridRow(int rows, int rowSize, const GenerateOptions& options, const std::function<void(int, int)>& fn);
+
+// Indexes the quads of grid, wrapping around the columns (and the rows when closed): a
+// list of exactly 6 indices per quad, or one restart-separated strip per row when
+// options.triangleStrips.
+void emitGridIndices(MeshData& mesh, const SurfaceGrid& grid, const GenerateOptions& options);
+
+// Vertex (i, j) of the grid is vertex j * columns + i, coloured vertexRandom(seed, vertex, c)
+// like the other generators. The output is byte-identical whatever the thread count.
+template <typename Surface>
+MeshData generateParametricSurface(const Surface& surface, const SurfaceGrid& grid, std::uint32_t seed = 0,
+    const GenerateOptions& options = {})
+{
+    constexpr int attribCount = MeshData::attribCount;
+    constexpr int block = 8; // vertices evaluated together, so the surface's arithmetic vectorises
+
+    MeshData mesh;
+    const int n = grid.columns;
+    const int spans = grid.closedRows ? grid.rows : grid.rows - 1;
+    if (n < 1 || spans < 1) {
+        return mesh;
+    }
+    mesh.vertices.resize(static_cast<std::size_t>(n) * grid.rows * attribCount);
+
+    const RingTable& around = ringTable(n);
+    const RingTable& along = ringTable(grid.closedRows ? grid.rows : 2 * spans);
+    forEachGridRow(grid.rows, n, options, [&](int rowBegin, int rowEnd) {
+        SurfacePoint points[block];
+        SurfaceSample samples[block];
+        for (int j = rowBegin; j < rowEnd; ++j) {
+            const float v = static_cast<float>(j) / static_cast<float>(spans);
+            for (int i0 = 0; i0 < n; i0 += block) {
+                const int count = std::min(block, n - i0);
+                for (int l = 0; l < count; ++l) {
+                    const int i = i0 + l;
+                    const int angle = static_cast<int>(static_cast<std::int64_t>(i) * grid.columnStep % n);
+                    points[l] = { static_cast<float>(i) / static_cast<float>(n), v,
+                        around.cos[angle], around.sin[angle], along.cos[j], along.sin[j] };
+                }
+                for (int l = 0; l < block; ++l) {
+                    samples[l] = surface(points[l < count ? l : 0]);
+                }
+
+                const std::uint32_t first = static_cast<std::uint32_t>(j) * n + i0;
+                float* vertex = &mesh.vertices[static_cast<std::size_t>(first) * attribCount];
+                for (int l = 0; l < count; ++l, vertex += attribCount) {
+                    const SurfaceSample& sample = samples[l];
+                    vertex[0] = sample.position[0];
+                    vertex[1] = sample.position[1];
+                    vertex[2] = sample.position[2];
+                    vertex[3] = vertexRandom(seed, first + l, 0);
+                    vertex[4] = vertexRandom(seed, first + l, 1);
+                    vertex[5] = vertexRandom(seed, first + l, 2);
+                    vertex[6] = sample.texCoord[0];
+                    vertex[7] = sample.texCoord[1];
+                    vertex[8] = sample.normal[0];
+                    vertex[9] = sample.normal[1];
+                    vertex[10] = sample.normal[2];
+                }
+            }
+        }
+    });
+
+    emitGridIndices(mesh, grid, options);
+    return mesh;
+}
+
+// Radius r around the z axis, rows from pole to pole. Texture coordinates project the
+// sphere onto the xy plane. Use on an open grid.
+struct SphereSurface
+{
+    float r;
+
+    SurfaceSample operator()(const SurfacePoint& p) const
+    {
+        const float x = p.cosU * p.sinV;
+        const float y = p.sinU * p.sinV;
+        return { { r * x, r * y, r * p.cosV }, { x, y, p.cosV }, { 0.5f * x + 0.5f, 0.5f * y + 0.5f } };
+    }
+};
+
+// Sweep radius R, tube radius r: the tube goes round u, the sweep round v. Use on a closed grid.
+struct TorusSurface
+{
+    float R;
+    float r;
+
+    SurfaceSample operator()(const SurfacePoint& p) const
+    {
+        const float radial = R + r * p.cosU;
+        return { { radial * p.sinV, radial * p.cosV, r * p.sinU },
+            { p.cosU * p.sinV, p.cosU * p.cosV, p.sinU }, { p.u, p.v } };
+    }
+};
+
+#endif // PARAMETRICSURFACE_H
@@ -0,0 +1,85 @@
+#include "PolynomialCurves.hpp"
+
+#include <algorithm>
+
+namespace {
+    CurveInstance toInstance(const Polynomial& p, float low, float high)
+    {
+        return { p.a, p.b, p.c, p.d, p.e, p.r, p.s, low, high };
+    }
+}
+
+PolynomialCurves::PolynomialCurves(int samples, bool ySquared, float clip)
+    : samples(samples)
+    , ySquared(ySquared)
+    , clip(clip)
+{
+    m_vao.bind();
+    m_instances.bind();
+    constexpr GLsizei stride = sizeof(CurveInstance);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(CurveInstance, a));
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(CurveInstance, e));
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(CurveInstance, low));
+    for (GLuint location = 0; location < 3; ++location) {
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
+    m_vao.unBind();
+    m_instances.unBind();
+}
+
+std::size_t PolynomialCurves::add(const Polynomial& polynomial, float low, float high)
+{
+    m_curves.push_back(toInstance(polynomial, low, high));
+    const std::size_t curve = m_curves.size() - 1;
+    m_dirtyBegin = m_dirtyBegin < m_dirtyEnd ? std::min(m_dirtyBegin, curve) : curve;
+    m_dirtyEnd = curve + 1;
+    return curve;
+}
+
+void PolynomialCurves::set(std::size_t curve, const Polynomial& polynomial, float low, float high)
+{
+    m_curves.at(curve) = toInstance(polynomial, low, high);
+    m_dirtyBegin = m_dirtyBegin < m_dirtyEnd ? std::min(m_dirtyBegin, curve) : curve;
+    m_dirtyEnd = std::max(m_dirtyEnd, curve + 1);
+}
+
+void PolynomialCurves::clear()
+{
+    m_curves.clear();
+    m_dirtyBegin = m_dirtyEnd = 0;
+}
+
+std::size_t PolynomialCurves::size() const
+{
+    return m_curves.size();
+}
+
+void PolynomialCurves::upload()
+{
+    m_instances.bind();
+    if (m_curves.size() > m_capacity) {
+        // grow geometrically so adding curves one by one stays cheap
+        m_capacity = std::max(m_curves.size(), 2 * m_capacity);
+        glBufferData(GL_ARRAY_BUFFER, m_capacity * sizeof(CurveInstance), nullptr, GL_DYNAMIC_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, m_curves.size() * sizeof(CurveInstance), m_curves.data());
+    }
+    else if (m_dirtyBegin < m_dirtyEnd) {
+        glBufferSubData(GL_ARRAY_BUFFER, m_dirtyBegin * sizeof(CurveInstance),
+            (m_dirtyEnd - m_dirtyBegin) * sizeof(CurveInstance), m_curves.data() + m_dirtyBegin);
+    }
+    m_instances.unBind();
+    m_dirtyBegin = m_dirtyEnd = 0;
+}
+
+void PolynomialCurves::draw()
+{
+    if (m_curves.empty() || samples < 2) {
+        return;
+    }
+    upload();
+    glVertexAttrib4f(3, float(samples), ySquared ? 1.0f : 0.0f, clip, curvePlotScale);
+    m_vao.bind();
+    glDrawArraysInstanced(GL_LINE_STRIP, 0, samples, static_cast<GLsizei>(m_curves.size()));
+    m_vao.unBind();
+}
@@ -0,0 +1,63 @@
+#ifndef POLYNOMIALCURVES_H
+#define POLYNOMIALCURVES_H
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "VAO.hpp"
+#include "VBO.hpp"
+#include "MeshGenerators.hpp"
+#include "PolynomialKernel.hpp"
+
+#include <cstddef>
+#include <vector>
+
+// One curve as curve.vert reads it: 36 bytes per instance.
+struct CurveInstance
+{
+    float a, b, c, d, e, r, s;
+    float low, high;
+};
+static_assert(sizeof(CurveInstance) == 36);
+
+// Polynomial curves evaluated on the GPU: every curve is an instance of one GL_LINE_STRIP
+// whose x comes from gl_VertexID, so there is no vertex buffer, and changing a curve's
+// coefficients rewrites only its 36 bytes of the instance buffer. Draw with curve.vert and
+// curve.frag. Samples are uniform; generateAdaptivePolynomial suits curves that stay put.
+class PolynomialCurves
+{
+public:
+    // ySquared and clip apply to every curve of the batch; clip is in plotted units, as
+    // in PolynomialSampling.
+    explicit PolynomialCurves(int samples = 256, bool ySquared = false, float clip = 10.0f);
+
+    std::size_t add(const Polynomial& polynomial, float low, float high); // returns the curve's index
+    void set(std::size_t curve, const Polynomial& polynomial, float low, float high); // polynomial.ySquared is ignored
+    void clear();
+    std::size_t size() const;
+
+    // Uploads what changed since the last draw (only the range between the first and last
+    // changed curve), then draws every curve with one instanced call.
+    void draw();
+
+    int samples;
+    bool ySquared;
+    float clip;
+
+    PolynomialCurves(const PolynomialCurves& other) = delete;
+    PolynomialCurves& operator=(const PolynomialCurves& other) = delete;
+    PolynomialCurves(PolynomialCurves&& other) = delete;
+    PolynomialCurves& operator=(PolynomialCurves&& other) = delete;
+
+private:
+    void upload();
+
+    std::vector<CurveInstance> m_curves;
+    VAO m_vao;
+    VBO m_instances;
+    std::size_t m_capacity{ 0 }; // curves the instance buffer has room for
+    std::size_t m_dirtyBegin{ 0 };
+    std::size_t m_dirtyEnd{ 0 };
+};
+
+#endif // POLYNOMIALCURVES_H
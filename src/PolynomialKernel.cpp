@@ -0,0 +1,83 @@
+#include "PolynomialKernel.hpp"
+
+#include <cmath>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+namespace {
+    float evaluateScalar(const Polynomial& p, float x)
+    {
+        float y = (((p.a * x + p.b) * x + p.c) * x + p.d) * x + p.e;
+        if (p.hasPole()) {
+            const float u = 1.0f / x;
+            y += (p.s * u + p.r) * u;
+        }
+        return p.ySquared ? std::sqrt(y) : y;
+    }
+
+#if defined(__AVX2__)
+    constexpr std::size_t lanes = 8;
+
+    void evaluateLanes(const Polynomial& p, const float* x, float* y)
+    {
+        const __m256 vx = _mm256_loadu_ps(x);
+        __m256 v = _mm256_set1_ps(p.a);
+        v = _mm256_add_ps(_mm256_mul_ps(v, vx), _mm256_set1_ps(p.b));
+        v = _mm256_add_ps(_mm256_mul_ps(v, vx), _mm256_set1_ps(p.c));
+        v = _mm256_add_ps(_mm256_mul_ps(v, vx), _mm256_set1_ps(p.d));
+        v = _mm256_add_ps(_mm256_mul_ps(v, vx), _mm256_set1_ps(p.e));
+        if (p.hasPole()) {
+            const __m256 u = _mm256_div_ps(_mm256_set1_ps(1.0f), vx);
+            const __m256 w = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p.s), u), _mm256_set1_ps(p.r));
+            v = _mm256_add_ps(v, _mm256_mul_ps(w, u));
+        }
+        if (p.ySquared) {
+            v = _mm256_sqrt_ps(v);
+        }
+        _mm256_storeu_ps(y, v);
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    constexpr std::size_t lanes = 4;
+
+    void evaluateLanes(const Polynomial& p, const float* x, float* y)
+    {
+        const __m128 vx = _mm_loadu_ps(x);
+        __m128 v = _mm_set1_ps(p.a);
+        v = _mm_add_ps(_mm_mul_ps(v, vx), _mm_set1_ps(p.b));
+        v = _mm_add_ps(_mm_mul_ps(v, vx), _mm_set1_ps(p.c));
+        v = _mm_add_ps(_mm_mul_ps(v, vx), _mm_set1_ps(p.d));
+        v = _mm_add_ps(_mm_mul_ps(v, vx), _mm_set1_ps(p.e));
+        if (p.hasPole()) {
+            const __m128 u = _mm_div_ps(_mm_set1_ps(1.0f), vx);
+            const __m128 w = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.s), u), _mm_set1_ps(p.r));
+            v = _mm_add_ps(v, _mm_mul_ps(w, u));
+        }
+        if (p.ySquared) {
+            v = _mm_sqrt_ps(v);
+        }
+        _mm_storeu_ps(y, v);
+    }
+#else
+    constexpr std::size_t lanes = 4;
+
+    void evaluateLanes(const Polynomial& p, const float* x, float* y)
+    {
+        for (std::size_t l = 0; l < lanes; ++l) {
+            y[l] = evaluateScalar(p, x[l]);
+        }
+    }
+#endif
+}
+
+void evaluatePolynomial(const Polynomial& polynomial, const float* x, float* y, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + lanes <= count; i += lanes) {
+        evaluateLanes(polynomial, x + i, y + i);
+    }
+    for (; i < count; ++i) {
+        y[i] = evaluateScalar(polynomial, x[i]);
+    }
+}
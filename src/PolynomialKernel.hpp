@@ -0,0 +1,28 @@
+#ifndef POLYNOMIALKERNEL_H
+#define POLYNOMIALKERNEL_H
+
+#include <cstddef>
+
+// y = ax^4 + bx^3 + cx^2 + dx + e + r/x + s/x^2, or its square root when ySquared
+// (the curve is given in y^2).
+struct Polynomial
+{
+    float a{ 0.0f };
+    float b{ 0.0f };
+    float c{ 0.0f };
+    float d{ 0.0f };
+    float e{ 0.0f };
+    float r{ 0.0f };
+    float s{ 0.0f };
+    bool ySquared{ false };
+
+    bool hasPole() const { return r != 0.0f || s != 0.0f; } // at x = 0
+};
+
+// Writes y for each of count x values, evaluated in Horner form:
+// (((ax + b)x + c)x + d)x + e + (s/x + r)/x. Where the curve is undefined (at the pole, or
+// under a negative square) y is NaN or infinite. Uses AVX2/SSE2 when the build enables
+// them, scalar otherwise.
+void evaluatePolynomial(const Polynomial& polynomial, const float* x, float* y, std::size_t count);
+
+#endif // POLYNOMIALKERNEL_H
@@ -0,0 +1,113 @@
+#include "ProceduralShapeBatch.hpp"
+
+#include <algorithm>
+
+ProceduralShapeBatch::ProceduralShapeBatch()
+{
+    m_vao.bind();
+    m_buffer.bind();
+    for (GLuint location = 0; location < 3; ++location) {
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
+    pointAttributes(0);
+    m_vao.unBind();
+    m_buffer.unBind();
+}
+
+std::size_t ProceduralShapeBatch::add(const ProceduralInstance& instance)
+{
+    m_instances.push_back(instance);
+    m_dirty = true;
+    return m_instances.size() - 1;
+}
+
+void ProceduralShapeBatch::set(std::size_t index, const ProceduralInstance& instance)
+{
+    m_instances.at(index) = instance;
+    m_dirty = true;
+}
+
+void ProceduralShapeBatch::clear()
+{
+    m_instances.clear();
+    m_groups.clear();
+    m_dirty = false;
+}
+
+std::size_t ProceduralShapeBatch::size() const
+{
+    return m_instances.size();
+}
+
+// GL 3.3 has no base instance, so each group starts at offset 0 of attributes pointed at
+// its first instance.
+void ProceduralShapeBatch::pointAttributes(std::size_t first) const
+{
+    constexpr GLsizei stride = sizeof(ProceduralInstance);
+    const std::size_t base = first * sizeof(ProceduralInstance);
+    glVertexAttribIPointer(0, 4, GL_UNSIGNED_INT, stride, (void*)(base + offsetof(ProceduralInstance, kind)));
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, (void*)(base + offsetof(ProceduralInstance, radius)));
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (void*)(base + offsetof(ProceduralInstance, position)));
+}
+
+void ProceduralShapeBatch::upload()
+{
+    std::vector<ProceduralInstance> sorted;
+    sorted.reserve(m_instances.size());
+    for (const ProceduralInstance& instance : m_instances) {
+        if (proceduralVertexCount(instance) > 0) {
+            sorted.push_back(instance);
+        }
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [](const ProceduralInstance& a, const ProceduralInstance& b) {
+        return a.columns != b.columns ? a.columns < b.columns : a.rows < b.rows;
+    });
+
+    m_groups.clear();
+    for (std::size_t i = 0; i < sorted.size(); ++i) {
+        if (m_groups.empty() || m_groups.back().columns != sorted[i].columns || m_groups.back().rows != sorted[i].rows) {
+            m_groups.push_back({ sorted[i].columns, sorted[i].rows, i, 0 });
+        }
+        ++m_groups.back().count;
+    }
+
+    m_buffer.bind();
+    if (sorted.size() > m_capacity) {
+        m_capacity = std::max(sorted.size(), 2 * m_capacity);
+        glBufferData(GL_ARRAY_BUFFER, m_capacity * sizeof(ProceduralInstance), nullptr, GL_DYNAMIC_DRAW);
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sorted.size() * sizeof(ProceduralInstance), sorted.data());
+    m_buffer.unBind();
+    m_dirty = false;
+}
+
+void ProceduralShapeBatch::draw()
+{
+    drawGroups(GL_TRIANGLES, 6);
+}
+
+void ProceduralShapeBatch::drawPatches()
+{
+    glPatchParameteri(GL_PATCH_VERTICES, 4);
+    drawGroups(GL_PATCHES, 4);
+}
+
+void ProceduralShapeBatch::drawGroups(GLenum mode, GLsizei verticesPerQuad)
+{
+    if (m_dirty) {
+        upload();
+    }
+    if (m_groups.empty()) {
+        return;
+    }
+    m_vao.bind();
+    m_buffer.bind();
+    for (const Group& group : m_groups) {
+        pointAttributes(group.first);
+        glDrawArraysInstanced(mode, 0, verticesPerQuad * static_cast<GLsizei>(group.columns * group.rows),
+            static_cast<GLsizei>(group.count));
+    }
+    m_buffer.unBind();
+    m_vao.unBind();
+}
@@ -0,0 +1,64 @@
+#ifndef PROCEDURALSHAPEBATCH_H
+#define PROCEDURALSHAPEBATCH_H
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "VAO.hpp"
+#include "VBO.hpp"
+#include "ProceduralShapes.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Spheres, tori, cones and cylinders rebuilt by procedural.vert from gl_VertexID and a
+// 36-byte instance each, so shapes of any radius take no vertex memory. Instances that
+// share a resolution are one instanced draw whatever their kind or radii: a thousand tori
+// of different radii at the same n are a single glDrawArraysInstanced. Draw with
+// procedural.vert and default.frag.
+class ProceduralShapeBatch
+{
+public:
+    ProceduralShapeBatch();
+
+    std::size_t add(const ProceduralInstance& instance); // returns the instance's index
+    void set(std::size_t index, const ProceduralInstance& instance);
+    void clear();
+    std::size_t size() const;
+
+    // Re-uploads the instances if any changed since the last draw, then issues one
+    // instanced draw per resolution.
+    void draw();
+
+    // The same instances as quad patches, four vertices per grid quad, for tessellation
+    // shaders (tessellated.vert/.tesc/.tese). Needs a GL 4.0 context.
+    void drawPatches();
+
+    ProceduralShapeBatch(const ProceduralShapeBatch& other) = delete;
+    ProceduralShapeBatch& operator=(const ProceduralShapeBatch& other) = delete;
+    ProceduralShapeBatch(ProceduralShapeBatch&& other) = delete;
+    ProceduralShapeBatch& operator=(ProceduralShapeBatch&& other) = delete;
+
+private:
+    struct Group
+    {
+        std::uint32_t columns;
+        std::uint32_t rows;
+        std::size_t first; // in the sorted instance buffer
+        std::size_t count;
+    };
+
+    void upload();
+    void drawGroups(GLenum mode, GLsizei verticesPerQuad);
+    void pointAttributes(std::size_t first) const;
+
+    std::vector<ProceduralInstance> m_instances;
+    std::vector<Group> m_groups;
+    VAO m_vao;
+    VBO m_buffer;
+    std::size_t m_capacity{ 0 }; // instances the buffer has room for
+    bool m_dirty{ false };
+};
+
+#endif // PROCEDURALSHAPEBATCH_H
@@ -0,0 +1,145 @@
+#include "ProceduralShapes.hpp"
+#include "VertexRandom.hpp"
+
+#include <cmath>
+#include <numbers>
+
+namespace {
+    constexpr int attribCount = MeshData::attribCount;
+
+    // Quad corners as (column, row) steps, two counter-clockwise triangles.
+    constexpr std::uint32_t cornerColumn[6] = { 0, 0, 1, 1, 1, 0 };
+    constexpr std::uint32_t cornerRow[6] = { 0, 1, 1, 1, 0, 0 };
+}
+
+ProceduralInstance proceduralSphere(int n, float r, std::uint32_t seed)
+{
+    return { ProceduralKind::Sphere, std::uint32_t(n), std::uint32_t(n), seed, r, 0.0f };
+}
+
+ProceduralInstance proceduralTorus(int n, float R, std::uint32_t seed)
+{
+    return { ProceduralKind::Torus, std::uint32_t(n), std::uint32_t(n), seed, R / 2, R };
+}
+
+ProceduralInstance proceduralCone(int n, float r, std::uint32_t seed)
+{
+    return { ProceduralKind::Cone, std::uint32_t(n), 2, seed, r, 1.0f };
+}
+
+ProceduralInstance proceduralCylinder(int n, float r, std::uint32_t seed)
+{
+    return { ProceduralKind::Cylinder, std::uint32_t(n), 3, seed, r, 1.0f };
+}
+
+float proceduralBoundingRadius(const ProceduralInstance& instance)
+{
+    switch (instance.kind) {
+    case ProceduralKind::Sphere:
+        return instance.radius;
+    case ProceduralKind::Torus:
+        return instance.size + instance.radius;
+    default:
+        return std::sqrt(instance.radius * instance.radius + instance.size * instance.size);
+    }
+}
+
+void proceduralVertex(const ProceduralInstance& instance, std::uint32_t vertexId, float* out)
+{
+    const std::uint32_t quad = vertexId / 6;
+    const std::uint32_t corner = vertexId % 6;
+    const std::uint32_t column = quad % instance.columns + cornerColumn[corner];
+    const std::uint32_t row = quad / instance.columns; // the surface piece comes from the quad's row
+    const std::uint32_t step = cornerRow[corner];
+
+    const float u = float(column) / float(instance.columns);
+    const float v = float(row + step) / float(instance.rows);
+    const float theta = 2.0f * std::numbers::pi_v<float> * u;
+    const float c = std::cos(theta);
+    const float s = std::sin(theta);
+    const float r = instance.radius;
+    const float h = instance.size;
+
+    float position[3];
+    float normal[3];
+    switch (instance.kind) {
+    case ProceduralKind::Sphere: {
+        const float phi = std::numbers::pi_v<float> * v;
+        normal[0] = std::sin(phi) * c;
+        normal[1] = std::sin(phi) * s;
+        normal[2] = std::cos(phi);
+        for (int k = 0; k < 3; ++k) {
+            position[k] = r * normal[k];
+        }
+        break;
+    }
+    case ProceduralKind::Torus: {
+        const float alpha = 2.0f * std::numbers::pi_v<float> * v;
+        normal[0] = c * std::cos(alpha);
+        normal[1] = c * std::sin(alpha);
+        normal[2] = s;
+        position[0] = (h + r * c) * std::cos(alpha);
+        position[1] = (h + r * c) * std::sin(alpha);
+        position[2] = r * s;
+        break;
+    }
+    case ProceduralKind::Cone:
+    case ProceduralKind::Cylinder:
+    default: {
+        // caps fan out from their centre; cone sides close in on the apex
+        const bool cone = instance.kind == ProceduralKind::Cone;
+        const std::uint32_t last = instance.rows - 1;
+        const bool bottom = row == 0;
+        const bool top = !cone && row == last;
+        float ring = r;
+        float y;
+        if (bottom) {
+            ring = r * float(step);
+            y = -h;
+        } else if (top) {
+            ring = r * float(1 - step);
+            y = h;
+        } else {
+            ring = cone ? r * float(1 - step) : r;
+            y = step ? h : -h;
+        }
+        position[0] = ring * c;
+        position[1] = y;
+        position[2] = ring * s;
+        if (bottom || top) {
+            normal[0] = 0.0f;
+            normal[1] = bottom ? -1.0f : 1.0f;
+            normal[2] = 0.0f;
+        } else {
+            const float slope = cone ? r / (2.0f * h) : 0.0f; // outward normal of the slanted side
+            const float length = std::sqrt(1.0f + slope * slope);
+            normal[0] = c / length;
+            normal[1] = slope / length;
+            normal[2] = s / length;
+        }
+        break;
+    }
+    }
+
+    const std::uint32_t gridVertex = (column % instance.columns) + (row + step) * instance.columns;
+    for (int k = 0; k < 3; ++k) {
+        out[k] = position[k] + instance.position[k];
+        out[3 + k] = vertexRandom(instance.seed, gridVertex, k);
+        out[8 + k] = normal[k];
+    }
+    out[6] = u;
+    out[7] = v;
+}
+
+MeshData generateProcedural(const ProceduralInstance& instance)
+{
+    MeshData mesh;
+    const std::uint32_t count = proceduralVertexCount(instance);
+    mesh.vertices.resize(std::size_t(count) * attribCount);
+    mesh.indices.resize(count);
+    for (std::uint32_t v = 0; v < count; ++v) {
+        proceduralVertex(instance, v, &mesh.vertices[std::size_t(v) * attribCount]);
+        mesh.indices[v] = v;
+    }
+    return mesh;
+}
@@ -0,0 +1,62 @@
+#ifndef PROCEDURALSHAPES_H
+#define PROCEDURALSHAPES_H
+
+#include "MeshData.hpp"
+
+#include <cstdint>
+
+// Shapes whose vertices are closed-form functions of their index, so a vertex shader can
+// rebuild them from gl_VertexID and a few per-instance parameters with no vertex buffer.
+// proceduralVertex() is the CPU reference for shaders/procedural.vert: keep the two in step.
+//
+// Every shape is a columns x rows grid of quads drawn as a plain triangle list, six vertices
+// per quad, wound counter-clockwise seen from outside. Colours are vertexRandom(seed, ...)
+// keyed on the grid vertex, like the generators' seeded colours.
+
+enum class ProceduralKind : std::uint32_t
+{
+    Sphere,   // rows from pole to pole
+    Torus,    // rows around the sweep
+    Cone,     // rows: base cap, side up to the apex
+    Cylinder, // rows: bottom cap, side, top cap
+};
+
+// One instance as procedural.vert reads it: 36 bytes.
+//  radius: sphere, cone and cylinder radius; the tube radius of a torus
+//  size: torus sweep radius; half the height of a cone or cylinder
+struct ProceduralInstance
+{
+    ProceduralKind kind{ ProceduralKind::Sphere };
+    std::uint32_t columns{ 0 };
+    std::uint32_t rows{ 0 };
+    std::uint32_t seed{ 0 };
+    float radius{ 1.0f };
+    float size{ 0.0f };
+    float position[3]{ 0.0f, 0.0f, 0.0f };
+};
+static_assert(sizeof(ProceduralInstance) == 36);
+
+// Proportions follow the generators: the torus tube is half of R, cones and cylinders
+// run from y = -1 to 1.
+ProceduralInstance proceduralSphere(int n, float r = 1.0f, std::uint32_t seed = 0);
+ProceduralInstance proceduralTorus(int n, float R = 0.5f, std::uint32_t seed = 0);
+ProceduralInstance proceduralCone(int n, float r = 1.0f, std::uint32_t seed = 0);
+ProceduralInstance proceduralCylinder(int n, float r = 0.8f, std::uint32_t seed = 0);
+
+constexpr std::uint32_t proceduralVertexCount(const ProceduralInstance& instance)
+{
+    return 6 * instance.columns * instance.rows;
+}
+
+// Radius of the sphere about instance.position that holds the shape.
+float proceduralBoundingRadius(const ProceduralInstance& instance);
+
+// Writes vertex vertexId of instance in the MeshData::attribCount layout, position
+// offset by instance.position.
+void proceduralVertex(const ProceduralInstance& instance, std::uint32_t vertexId, float* out);
+
+// Every vertex of instance, for validating the shader path against ShapeMesh (e.g. under a
+// software GL renderer) or drawing it where the procedural path is unavailable.
+MeshData generateProcedural(const ProceduralInstance& instance);
+
+#endif // PROCEDURALSHAPES_H
@@ -0,0 +1,112 @@
+#include "RingKernel.hpp"
+#include "MeshData.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <numbers>
+#include <shared_mutex>
+#include <unordered_map>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+namespace {
+#if defined(__AVX2__)
+    constexpr int lanes = 8;
+
+    void affineLanes(const float* c, const float* s, const RingTerm& term, float* out)
+    {
+        const __m256 v = _mm256_add_ps(
+            _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(term.a), _mm256_loadu_ps(c)),
+                _mm256_mul_ps(_mm256_set1_ps(term.b), _mm256_loadu_ps(s))),
+            _mm256_set1_ps(term.c));
+        _mm256_store_ps(out, v);
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    constexpr int lanes = 4;
+
+    void affineLanes(const float* c, const float* s, const RingTerm& term, float* out)
+    {
+        const __m128 v = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(_mm_set1_ps(term.a), _mm_loadu_ps(c)),
+                _mm_mul_ps(_mm_set1_ps(term.b), _mm_loadu_ps(s))),
+            _mm_set1_ps(term.c));
+        _mm_store_ps(out, v);
+    }
+#else
+    constexpr int lanes = 4;
+
+    void affineLanes(const float* c, const float* s, const RingTerm& term, float* out)
+    {
+        for (int l = 0; l < lanes; ++l) {
+            out[l] = term.a * c[l] + term.b * s[l] + term.c;
+        }
+    }
+#endif
+}
+
+const RingTable& ringTable(int n)
+{
+    static std::shared_mutex mutex;
+    static std::unordered_map<int, std::unique_ptr<RingTable>> tables;
+
+    {
+        std::shared_lock lock(mutex);
+        if (auto it = tables.find(n); it != tables.end()) {
+            return *it->second;
+        }
+    }
+
+    auto table = std::make_unique<RingTable>();
+    table->n = n;
+    table->cos.resize(n);
+    table->sin.resize(n);
+    for (int j = 0; j < n; ++j) {
+        const double angle = j * 2.0 * std::numbers::pi / n;
+        table->cos[j] = static_cast<float>(std::cos(angle));
+        table->sin[j] = static_cast<float>(std::sin(angle));
+    }
+
+    std::unique_lock lock(mutex);
+    auto [it, inserted] = tables.try_emplace(n, std::move(table));
+    return *it->second;
+}
+
+void emitRing(float* dst, int count, const RingTable& table, std::span<const RingTerm> terms, int first, int step)
+{
+    constexpr int stride = MeshData::attribCount;
+    alignas(32) float gatheredCos[lanes];
+    alignas(32) float gatheredSin[lanes];
+    alignas(32) float out[lanes];
+
+    for (int j = 0; j < count; j += lanes) {
+        const int block = std::min(lanes, count - j);
+        const std::int64_t start = (first + static_cast<std::int64_t>(j) * step) % table.n;
+
+        const float* c = gatheredCos;
+        const float* s = gatheredSin;
+        if (step == 1 && block == lanes && start + lanes <= table.n) {
+            c = table.cos.data() + start;
+            s = table.sin.data() + start;
+        }
+        else {
+            for (int l = 0; l < lanes; ++l) {
+                const std::int64_t index = (first + static_cast<std::int64_t>(j + l) * step) % table.n;
+                gatheredCos[l] = l < block ? table.cos[index] : 0.0f;
+                gatheredSin[l] = l < block ? table.sin[index] : 0.0f;
+            }
+        }
+
+        for (const RingTerm& term : terms) {
+            affineLanes(c, s, term, out);
+            float* vertex = dst + static_cast<std::size_t>(j) * stride + term.offset;
+            for (int l = 0; l < block; ++l, vertex += stride) {
+                *vertex = out[l];
+            }
+        }
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef RINGKERNEL_H
+#define RINGKERNEL_H
+
+#include <span>
+#include <vector>
+
+// cos/sin of j * 2pi / n for j in [0, n). Built once per n and shared by every
+// generator (and thread) that asks for the same resolution.
+struct RingTable
+{
+    int n;
+    std::vector<float> cos;
+    std::vector<float> sin;
+};
+
+const RingTable& ringTable(int n);
+
+// One vertex component written as an affine function of the ring angle:
+// vertex[offset] = a * cos + b * sin + c
+struct RingTerm
+{
+    int offset;
+    float a;
+    float b;
+    float c;
+};
+
+// Emits count consecutive MeshData::attribCount-wide vertices at dst, vertex j
+// taking the table angle (first + j * step) mod n. Only the components named in
+// terms are written. Uses AVX2/SSE2 when the build enables them, scalar otherwise.
+void emitRing(float* dst, int count, const RingTable& table, std::span<const RingTerm> terms, int first = 0, int step = 1);
+
+#endif // RINGKERNEL_H
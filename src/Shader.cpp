@@ -4,21 +4,21 @@
 #include <fstream>
 #include <stdexcept>
 
+namespace {
+    GLuint compileStage(GLenum type, const std::string& source)
+    {
+        const char* text = source.c_str();
+        const GLuint shader = glCreateShader(type);
+        glShaderSource(shader, 1, &text, NULL);
+        glCompileShader(shader);
+        return shader;
+    }
+}
+
 Shader::Shader(const char* vertexFile, const char* fragmentFile)
 {
-    const std::string vertStr = get_file_contents(vertexFile);
-    const std::string fragStr = get_file_contents(fragmentFile);
-
-    const char* vertexSource = vertStr.c_str();
-    const char* fragmentSource = fragStr.c_str();
-
-    const GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexSource, NULL);
-    glCompileShader(vertexShader);
-
-    const GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fragmentSource, NULL);
-    glCompileShader(fragmentShader);
+    const GLuint vertexShader = compileStage(GL_VERTEX_SHADER, get_file_contents(vertexFile));
+    const GLuint fragmentShader = compileStage(GL_FRAGMENT_SHADER, get_file_contents(fragmentFile));
 
     program = glCreateProgram();
     glAttachShader(program, vertexShader);
@@ -29,6 +29,26 @@ Shader::Shader(const char* vertexFile, const char* fragmentFile)
     glDeleteShader(fragmentShader);
 }
 
+Shader::Shader(const char* vertexFile, const char* controlFile, const char* evaluationFile, const char* fragmentFile)
+{
+    const GLuint stages[] = {
+        compileStage(GL_VERTEX_SHADER, get_file_contents(vertexFile)),
+        compileStage(GL_TESS_CONTROL_SHADER, get_file_contents(controlFile)),
+        compileStage(GL_TESS_EVALUATION_SHADER, get_file_contents(evaluationFile)),
+        compileStage(GL_FRAGMENT_SHADER, get_file_contents(fragmentFile)),
+    };
+
+    program = glCreateProgram();
+    for (GLuint stage : stages) {
+        glAttachShader(program, stage);
+    }
+    glLinkProgram(program);
+
+    for (GLuint stage : stages) {
+        glDeleteShader(stage);
+    }
+}
+
 Shader::~Shader()
 {
     glDeleteProgram(program);
@@ -68,6 +88,11 @@ void Shader::setScale(GLfloat val) const {
     glUniform1f(location, val);
 }
 
+void Shader::setTessellation(GLfloat viewportWidth, GLfloat viewportHeight, GLfloat edgePixels) const {
+    glUniform2f(glGetUniformLocation(program, "viewport"), viewportWidth, viewportHeight);
+    glUniform1f(glGetUniformLocation(program, "edgePixels"), edgePixels);
+}
+
 void Shader::setMixer(GLfloat val) const {
     GLuint uniMixer = glGetUniformLocation(program, "mixer");
     glUniform1f(uniMixer, val);
@@ -14,6 +14,8 @@ class Shader
 {
 public:
     Shader(const char* vertexFile, const char* fragmentFile);
+    // With tessellation control and evaluation stages; needs a GL 4.0 context.
+    Shader(const char* vertexFile, const char* controlFile, const char* evaluationFile, const char* fragmentFile);
     ~Shader();
 
     void use() const;
@@ -30,6 +32,9 @@ public:
 
     void setMixer(GLfloat val) const;
 
+    // Viewport size in pixels and the screen length tessellated edges aim for.
+    void setTessellation(GLfloat viewportWidth, GLfloat viewportHeight, GLfloat edgePixels) const;
+
     std::string get_file_contents(const char* filename) const;
 
     Shader(const Shader& other) = delete;
@@ -1,623 +1,371 @@
 #include "ShapeMesh.hpp"
+#include "MeshGenerators.hpp"
+#include "MeshCleanup.hpp"
 
 #include "VAO.hpp"
 #include "VBO.hpp"
 #include "EBO.hpp"
 #include "Texture.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <limits>
 #include <numbers>
+#include <utility>
 #include <vector>
 
-void ShapeMesh::draw() const
-{
-    bind();
-    if (!indices.empty()) {
-        glDrawElements(primitive, indices.size(), GL_UNSIGNED_INT, 0);
-    }
-    else {
-        glDrawArrays(primitive, 0, vertices.size());
+namespace {
+    MeshData cleaned(MeshData mesh)
+    {
+        cleanMesh(mesh);
+        return mesh;
     }
-    unBind();
 }
 
-void ShapeMesh::setLayout() const
+GLenum toGLPrimitive(Primitive primitive)
 {
-    bind();
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GLfloat), vertices.data(), GL_STATIC_DRAW);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, attribCount * sizeof(float), (void*)0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, attribCount * sizeof(float), (void*)(3 * sizeof(float)));
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, attribCount * sizeof(float), (void*)(6 * sizeof(float)));
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, attribCount * sizeof(float), (void*)(8 * sizeof(float)));
-    glEnableVertexAttribArray(0);
-    glEnableVertexAttribArray(1);
-    glEnableVertexAttribArray(2);
-    glEnableVertexAttribArray(3);
-    unBind();
+    switch (primitive) {
+    case Primitive::Points: return GL_POINTS;
+    case Primitive::Lines: return GL_LINES;
+    case Primitive::TriangleStrip: return GL_TRIANGLE_STRIP;
+    default: return GL_TRIANGLES;
+    }
 }
 
-void ShapeMesh::bind() const
+GLenum toGLType(AttributeType type)
 {
-    vao.bind();
-    vbo.bind();
-    ebo.bind();
+    switch (type) {
+    case AttributeType::Snorm16: return GL_SHORT;
+    case AttributeType::Unorm16: return GL_UNSIGNED_SHORT;
+    case AttributeType::Unorm8: return GL_UNSIGNED_BYTE;
+    default: return GL_FLOAT;
+    }
 }
 
-void ShapeMesh::unBind() const
+GLenum toGLType(IndexType type)
 {
-    vbo.unBind();
-    vao.unBind();
-    ebo.unBind();
-    // Unbind EBO AFTER unbinding VAO, as the EBO is linked in the VAO
-    // This does not apply to the VBO because the VBO is already linked to the VAO during glVertexAttribPointer
+    switch (type) {
+    case IndexType::U8: return GL_UNSIGNED_BYTE;
+    case IndexType::U16: return GL_UNSIGNED_SHORT;
+    default: return GL_UNSIGNED_INT;
+    }
 }
 
-CoordinateAxesMesh::CoordinateAxesMesh()
+void setDequantization(const Dequantization& dequantization)
 {
-    GLfloat r = 10.0f;
-    vertices = {
-        0.0f, 0.0f, 0.0f,   1.0f, 1.0f, 1.0f,      0.0f, 1.0f,      0.0f, 0.0f, 1.0f,       //  2
-        r, 0.0f, 0.0f,      1.0f, 0.0f, 0.0f,      0.0f, 1.0f,      0.0f, 0.0f, 1.0f,       //  | 3
-        0.0f, r, 0.0f,      0.0f, 1.0f, 0.0f,      0.0f, 0.0f,      0.0f, 0.0f, 1.0f,       //  |/
-        0.0f, 0.0f, r,      0.0f, 0.0f, 1.0f,      1.0f, 1.0f,      0.0f, 0.0f, 1.0f,       //  0-----1
-    };
-
-    primitive = GL_LINES;
-    indices = {
-        0, 1,
-        0, 2,
-        0, 3
-    };
-
-    setLayout();
+    const auto& [scale, bias, octahedralNormals] = dequantization;
+    glVertexAttrib4f(4, scale[0], scale[1], scale[2], octahedralNormals ? 1.0f : 0.0f);
+    glVertexAttrib3f(5, bias[0], bias[1], bias[2]);
 }
 
-RectangleMesh::RectangleMesh(GLfloat height, GLfloat width)
+ShapeMesh::ShapeMesh(MeshData data, VertexLayout vertexLayout)
+    : layout(vertexLayout)
 {
-    vertices = {
-        -width / 2.0f, height / 2.0f, 0.0f,      1.0f, 0.0f, 0.0f,      0.0f, 1.0f,      0.0f, 0.0f, 1.0f,
-        -width / 2.0f, -height / 2.0f, 0.0f,     0.0f, 1.0f, 0.0f,      0.0f, 0.0f,      0.0f, 0.0f, 1.0f,     //  0-------2
-        width / 2.0f, height / 2.0f, 0.0f,       0.0f, 0.0f, 1.0f,      1.0f, 1.0f,      0.0f, 0.0f, 1.0f,     //  |       |
-        width / 2.0f, -height / 2.0f, 0.0f,      1.0f, 1.0f, 0.0f,      1.0f, 0.0f,      0.0f, 0.0f, 1.0f      //  1-------3
-    };
-
-    indices = {
-        0, 1, 2,
-        1, 3, 2
-    };
-
-    setLayout();
+    upload(std::move(data));
 }
 
-CuboidMesh::CuboidMesh( GLfloat width, GLfloat height, GLfloat depth)
-{
-    vertices = {
-        -width / 2.0f, height / 2.0f, depth / 2.0f,     1.0f, 0.0f, 0.0f,       0.0f, 1.0f,      0.0f, 0.0f, 1.0f, //front 0
-        -width / 2.0f, -height / 2.0f, depth / 2.0f,    0.0f, 1.0f, 0.0f,       0.0f, 0.0f,      0.0f, 0.0f, 1.0f,
-        width / 2.0f, height / 2.0f, depth / 2.0f,      0.0f, 0.0f, 1.0f,       1.0f, 1.0f,      0.0f, 0.0f, 1.0f,
-        width / 2.0f, -height / 2.0f, depth / 2.0f,     1.0f, 1.0f, 0.0f,       1.0f, 0.0f,      0.0f, 0.0f, 1.0f,
-
-        -width / 2.0f, height / 2.0f, -depth / 2.0f,    1.0f, 0.0f, 0.0f,       0.0f, 1.0f,      0.0f, 0.0f, -1.0f, //back 4
-        -width / 2.0f, -height / 2.0f, -depth / 2.0f,   0.0f, 1.0f, 0.0f,       0.0f, 0.0f,      0.0f, 0.0f, -1.0f,
-        width / 2.0f, height / 2.0f, -depth / 2.0f,     0.0f, 0.0f, 1.0f,       1.0f, 1.0f,      0.0f, 0.0f, -1.0f,
-        width / 2.0f, -height / 2.0f, -depth / 2.0f,    1.0f, 1.0f, 0.0f,       1.0f, 0.0f,      0.0f, 0.0f, -1.0f,
-
-        -width / 2.0f, height / 2.0f, -depth / 2.0f,    1.0f, 0.0f, 0.0f,       0.0f, 1.0f,      -1.0f, 0.0f, 0.0f, //left 8
-        -width / 2.0f, -height / 2.0f, -depth / 2.0f,   0.0f, 1.0f, 0.0f,       0.0f, 0.0f,      -1.0f, 0.0f, 0.0f,
-        -width / 2.0f, height / 2.0f, depth / 2.0f,     1.0f, 0.0f, 0.0f,       1.0f, 1.0f,      -1.0f, 0.0f, 0.0f,
-        -width / 2.0f, -height / 2.0f, depth / 2.0f,    0.0f, 1.0f, 0.0f,       1.0f, 0.0f,      -1.0f, 0.0f, 0.0f,
-
-        width / 2.0f, height / 2.0f, depth / 2.0f,      0.0f, 0.0f, 1.0f,       0.0f, 1.0f,     1.0f, 0.0f, 0.0f, //right 12
-        width / 2.0f, -height / 2.0f, depth / 2.0f,     1.0f, 1.0f, 0.0f,       0.0f, 0.0f,     1.0f, 0.0f, 0.0f,
-        width / 2.0f, height / 2.0f, -depth / 2.0f,     0.0f, 0.0f, 1.0f,       1.0f, 1.0f,     1.0f, 0.0f, 0.0f,
-        width / 2.0f, -height / 2.0f, -depth / 2.0f,    1.0f, 1.0f, 0.0f,       1.0f, 0.0f,     1.0f, 0.0f, 0.0f,
-
-        -width / 2.0f, height / 2.0f, -depth / 2.0f,    1.0f, 0.0f, 0.0f,       0.0f, 1.0f,     0.0f, 1.0f, 0.0f, //top 16
-        -width / 2.0f, height / 2.0f, depth / 2.0f,     1.0f, 0.0f, 0.0f,       0.0f, 0.0f,     0.0f, 1.0f, 0.0f,                    //  16       18
-        width / 2.0f, height / 2.0f, -depth / 2.0f,     0.0f, 0.0f, 1.0f,       1.0f, 1.0f,     0.0f, 1.0f, 0.0f,                    //     8 4--------6 14
-        width / 2.0f, height / 2.0f, depth / 2.0f,      0.0f, 0.0f, 1.0f,       1.0f, 0.0f,     0.0f, 1.0f, 0.0f,                    //      /|       /|
-                                                                                                                                        //  10 0--------2 | 12
-        -width / 2.0f, -height / 2.0f, -depth / 2.0f,   0.0f, 1.0f, 0.0f,       0.0f, 1.0f,     0.0f, -1.0f, 0.0f, //bottom 20       //     | |      | |
-        -width / 2.0f, -height / 2.0f, depth / 2.0f,    0.0f, 1.0f, 0.0f,       0.0f, 0.0f,     0.0f, -1.0f, 0.0f,                   //    9| 5------|-7 15
-        width / 2.0f, -height / 2.0f, -depth / 2.0f,    1.0f, 1.0f, 0.0f,       1.0f, 1.0f,     0.0f, -1.0f, 0.0f,                   //     |/       |/
-        width / 2.0f, -height / 2.0f, depth / 2.0f,     1.0f, 1.0f, 0.0f,       1.0f, 0.0f,     0.0f, -1.0f, 0.0f                    //  11 1--------3 13
-    };
-
-    indices = {
-        0, 1, 2,        1, 3, 2,
-        6, 7, 5,        5, 4, 6,
-        8, 9, 11,       11, 10, 8,
-        12, 13, 15,     15, 14, 12,
-        16, 17, 18,     17, 19, 18,
-        20, 21, 22,     21, 23, 22
-    };
-
-    setLayout();
+ShapeMesh::ShapeMesh(LodChain chain, VertexLayout vertexLayout)
+    : layout(vertexLayout)
+{
+    upload(std::move(chain.mesh));
+    lods = std::move(chain.levels);
+    lodCentre = chain.centre;
+    lodRadius = chain.radius;
+
+    if (!chain.morphTargets.empty()) {
+        m_morphBuffer = std::make_unique<VBO>();
+        vao.bind();
+        m_morphBuffer->bind();
+        glBufferData(GL_ARRAY_BUFFER, chain.morphTargets.size() * sizeof(GLfloat), chain.morphTargets.data(), GL_STATIC_DRAW);
+        glVertexAttribPointer(6, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), (void*)0);
+        glEnableVertexAttribArray(6);
+        m_morphBuffer->unBind();
+        vao.unBind();
+    }
 }
 
-CircleMesh::CircleMesh(int n, float r)
+std::shared_ptr<ShapeMesh> ShapeMesh::deferred(std::function<MeshData()> generator, VertexLayout vertexLayout)
 {
-    // n steps requires n+1 verts including middle
-    vertices = { 0.0f, 0.0f, 0.0f,    0.0f, 1.0f, 0.0f,   0.5f, 0.5f,   0.0f, 0.0f, -1.0f }; // middle vertex
-    vertices.resize(attribCount * (n + 1));
-
-    for (int i = attribCount, j = 0; i < vertices.size(); i += attribCount, ++j) {
-        vertices[i] = r * cos(j * 2 * std::numbers::pi / n);
-        vertices[i + 1] = r * sin(j * 2 * std::numbers::pi / n);
-        vertices[i + 2] = 0.0f;
+    auto mesh = std::make_shared<ShapeMesh>();
+    mesh->layout = vertexLayout;
+    mesh->m_generator = std::move(generator);
+    return mesh;
+}
 
-        vertices[i + 3] = rand() / (1.0 * RAND_MAX);
-        vertices[i + 4] = rand() / (1.0 * RAND_MAX);
-        vertices[i + 5] = rand() / (1.0 * RAND_MAX);
+void ShapeMesh::prefetch()
+{
+    if (m_generator) {
+        upload(std::exchange(m_generator, nullptr)());
+    }
+}
 
-        vertices[i + 6] = (vertices[i] / r + 1.0f) * 0.5f;
-        vertices[i + 7] = (vertices[i + 1] / r + 1.0f) * 0.5f;
+bool ShapeMesh::isPending() const
+{
+    return static_cast<bool>(m_generator);
+}
 
-        vertices[i + 8] = 0.0f;
-        vertices[i + 9] = 0.0f;
-        vertices[i + 10] = -1.0f;
+std::size_t ShapeMesh::prewarm(std::span<const std::shared_ptr<ShapeMesh>> meshes, double budgetMs)
+{
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t pending = 0;
+    for (const auto& mesh : meshes) {
+        if (!mesh->isPending()) {
+            continue;
+        }
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() >= budgetMs) {
+            ++pending;
+            continue;
+        }
+        mesh->prefetch();
     }
+    return pending;
+}
 
-    // need 3n indices
-    indices.resize(3 * n);
-    indices[0] = 0;
-    indices[1] = 1;
-    indices[2] = 2;
-    for (int i = 3; i < indices.size(); i += 3) {
-        indices[i] = 0;
-        indices[i + 1] = indices[i - 1];
-        indices[i + 2] = indices[i - 1] + 1;
+void ShapeMesh::upload(MeshData data)
+{
+    vertices = std::move(data.vertices);
+    indices = std::move(data.indices);
+    primitive = toGLPrimitive(data.primitive);
+    lods.clear();
+    lodLevel = 0;
+    lodMorph = 0.0f;
+    if (m_morphBuffer) {
+        vao.bind();
+        glDisableVertexAttribArray(6);
+        vao.unBind();
+        m_morphBuffer.reset();
     }
-    indices[indices.size() - 1] = indices[1];
-
     setLayout();
 }
 
-CylinderMesh::CylinderMesh(int n, float r)
+void ShapeMesh::draw()
 {
-    // n steps requires n+1 verts including middle
-    vertices.resize(attribCount * (n + 1) * 2);
-    float h = 1.0f;
-
-    //bottom circle
-    vertices[0] = 0.0f;
-    vertices[1] = -h;
-    vertices[2] = 0.0f;
-
-    vertices[3] = rand() / (1.0 * RAND_MAX);
-    vertices[4] = rand() / (1.0 * RAND_MAX);
-    vertices[5] = rand() / (1.0 * RAND_MAX);
-
-    vertices[6] = 0.5f;
-    vertices[7] = 0.5f;
-
-    vertices[8] = 0.0f;
-    vertices[9] = 0.0f;
-    vertices[10] = -1.0f;
-
-    int j = 0;
-    int i = attribCount;
-    for (; i < (vertices.size() - attribCount) / 2; i += attribCount, ++j) {
-        vertices[i] = r * cos(j * 2 * std::numbers::pi / n);
-        vertices[i + 1] = -h;
-        vertices[i + 2] = r * sin(j * 2 * std::numbers::pi / n);
-
-        vertices[i + 3] = rand() / (1.0 * RAND_MAX);
-        vertices[i + 4] = rand() / (1.0 * RAND_MAX);
-        vertices[i + 5] = rand() / (1.0 * RAND_MAX);
-
-        vertices[i + 6] = (vertices[i] / r + 1.0f) * 0.5f;
-        vertices[i + 7] = (vertices[i + 1] / r + 1.0f) * 0.5f;
-
-        vertices[i + 8] = 0.0f;
-        vertices[i + 9] = 0.0f;
-        vertices[i + 10] = -1.0f;
-    }
-
-    //top circle
-    for (j = 0; i < vertices.size() - attribCount; i += attribCount, ++j) {
-        vertices[i] = r * cos(j * 2 * std::numbers::pi / n);
-        vertices[i + 1] = h;
-        vertices[i + 2] = r * sin(j * 2 * std::numbers::pi / n);
-
-        vertices[i + 3] = rand() / (1.0 * RAND_MAX);
-        vertices[i + 4] = rand() / (1.0 * RAND_MAX);
-        vertices[i + 5] = rand() / (1.0 * RAND_MAX);
-
-        vertices[i + 6] = (vertices[i] / r + 1.0f) * 0.5f;
-        vertices[i + 7] = (vertices[i + 1] / r + 1.0f) * 0.5f;
+    prefetch();
+    setDequantization(dequantization);
+    glVertexAttrib1f(7, lodMorph);
+    bind();
 
-        vertices[i + 8] = 0.0f;
-        vertices[i + 9] = 0.0f;
-        vertices[i + 10] = -1.0f;
+    GLsizei count = indexCount;
+    std::size_t first = 0;
+    if (!lods.empty()) {
+        count = static_cast<GLsizei>(lods[lodLevel].indexCount);
+        first = lods[lodLevel].firstIndex;
     }
-
-    vertices[i] = 0.0f;
-    vertices[i + 1] = h;
-    vertices[i + 2] = 0.0f;
-
-    vertices[i + 3] = 0.0f;
-    vertices[i + 4] = 0.0f;
-    vertices[i + 5] = 0.0f;
-
-    vertices[i + 6] = 0.5f;
-    vertices[i + 7] = 0.5f;
-
-    vertices[i + 8] = 0.0f;
-    vertices[i + 9] = 0.0f;
-    vertices[i + 10] = -1.0f;
-
-    // need 3n indices
-    indices.resize(3 * n + 6 * n + 3 * n);
-
-    // bottom
-    // indices[0] = 0   indices[1] = 1   indices[2] = 2             // n=6 => points = 18
-    // indices[3] = 0   indices[4] = 2   indices[5] = 3             //
-    // indices[6] = 0   indices[7] = 3   indices[8] = 4             //       3______2
-    // indices[9] = 0   indices[10] = 4  indices[11] = 5            //       /      \
-    // indices[12] = 0  indices[13] = 5  indices[14] = 6            //     4/   0    \ 1
-    // indices[12] = 0  indices[13] = 5  indices[14] = 6            //      \        /
-    // indices[15] = 0  indices[16] = 6  indices[17 == 3n-1] = 1    //      5\______/6
-
-    int l = 1;
-    for (i = 0; i < 3*(n-1); i += 3, ++l) {
-        indices[i] = 0;             // indices[0] to indices[3n-6]
-        indices[i + 1] = l;         // indices[1] to indices[3n-5]
-        indices[i + 2] = l + 1;     // indices[2] to indices[3n-4]
+    const std::size_t indexBytes = indexType == GL_UNSIGNED_BYTE ? 1 : indexType == GL_UNSIGNED_SHORT ? 2 : 4;
+    const void* offset = reinterpret_cast<const void*>(first * indexBytes);
+
+    if (indexCount > 0 && primitive == GL_TRIANGLE_STRIP) {
+        // GL 3.3 has no GL_PRIMITIVE_RESTART_FIXED_INDEX, so the type's maximum is set explicitly
+        glEnable(GL_PRIMITIVE_RESTART);
+        glPrimitiveRestartIndex(restartIndex);
+        glDrawElements(primitive, count, indexType, offset);
+        glDisable(GL_PRIMITIVE_RESTART);
     }
-    indices[i] = 0;         // indices[3n-3]
-    indices[i + 1] = l;     // indices[3n-2]
-    indices[i + 2] = 1;     // indices[3n-1]
-
-    // hollow cone side
-    // indices[18 == 3n] = 7    indices[21] = 2     //       n=6 => points = 18 + 36
-    // indices[19] = 1          indices[22] = 8     //
-    // indices[20] = 2          indices[23] = 7     //       9______8
-                                                    //       /      \
-    // indices[24] = 8          indices[27] = 3     //    10/   13   \7
-    // indices[25] = 2          indices[28] = 9     //      \        /
-    // indices[26] = 3          indices[29] = 8     //     11\______/12
-
-    // indices[30] = 9          indices[33] = 4
-    // indices[31] = 3          indices[34] = 10
-    // indices[32] = 4          indices[35] = 9
-
-    // indices[36] = 10         indices[39] = 5     //       3______2
-    // indices[37] = 4          indices[40] = 11    //       /      \
-    // indices[38] = 5          indices[41] = 10    //     4/   0    \1
-                                                    //      \        /
-    // indices[42] = 11         indices[45] = 6     //      5\______/6
-    // indices[43] = 5          indices[46] = 12
-    // indices[44] = 6          indices[47] = 11
-
-    // indices[48] = 12         indices[51] = 1
-    // indices[49] = 6          indices[52] = 7
-    // indices[50] = 1          indices[53 == 18 + 2(18)-1 == 3n + 2(3n)-1] = 12
-
-    for (i = 3 * n, l = 1; i < (3 * n + 2 * 3 * n - 6); i += 6, ++l) {
-        indices[i] = n + l;             // indices[3n] to indices[3n + 2(3n)-6]
-        indices[i + 1] = l;             // indices[3n+1] to indices[3n + 2(3n)-5]
-        indices[i + 2] = l + 1;         // indices[3n+2] to indices[3n + 2(3n)-4]
-
-        indices[i + 3] = l + 1;         // indices[3n+3] to indices[3n + 2(3n)-3]
-        indices[i + 4] = n + l + 1;     // indices[3n+4] to indices[3n + 2(3n)-2]
-        indices[i + 5] = n + l;         // indices[3n+5] to indices[3n + 2(3n)-1]
+    else if (indexCount > 0) {
+        glDrawElements(primitive, count, indexType, offset);
     }
-    indices[i] = 2*n-(n-1); // redo last triangle
-    indices[i + 1] = n;
-    indices[i + 2] = 1;
-
-    indices[i + 3] = 2*n; // redo last triangle
-    indices[i + 4] = 2 * n - (n - 1);
-    indices[i + 5] = n;
-
-    //top
-    // n = 6 = > points = 18 + 36 + 18 = 72
-    int k = 3 * n + 2 * 3 * n;
-    for (i = 0, l = 1; i < 3 * (n - 1); i += 3, ++l) {
-        indices[k + i] = (n + 1) * 2 - 1;   // indices[3n + 2(3)n] to indices[3n-5] = last vertex
-        indices[k + i + 1] = n + l;         // indices[3n + 2(3)n + 1] to indices[3n-5]
-        indices[k + i + 2] = n + l + 1;     // indices[3n + 2(3)n + 2] to indices[3n-4]
+    else {
+        glDrawArrays(primitive, 0, vertexCount);
     }
-    indices[k + i] = (n + 1) * 2 - 1;       // last vertex
-    indices[k + i + 1] = n+l;               // indices[3n-2]
-    indices[k + i + 2] = n+1;               // indices[3n-1]
-
-    setLayout();
+    unBind();
 }
 
-PolynomialMesh::PolynomialMesh(float a, float b, float c, float d, float e, float r, float s, float low, float high, int n, bool ySquared)
+void ShapeMesh::draw(const glm::mat4& modelView, const glm::mat4& projection, float viewportHeight)
 {
-    float dx = (high - low) / float(n-1);
-    vertices.resize(attribCount * n);
-
-    float err = 0.00001;
-    for (int i = 0; i < vertices.size(); i+= attribCount) {
-        float x = low + (i / float(attribCount)) * dx;
-
-        float A = a * x * x * x * x;
-        float B = b * x * x * x;
-        float C = c * x * x;
-        float D = d * x;
-        float E = e;
-        float R;
-        float S;
-        if (std::abs(x) > err) {
-            R = r / x;
-            S = s / (x * x);
-        }
-        else {
-            R = std::numeric_limits<float>::max();
-            S = std::numeric_limits<float>::max();
-        }
-
-        float y = A + B + C + D + E + R + S;
-        if (ySquared) {
-            y = std::sqrt(y);
-        }
-
-        x *= 0.15f;
-        y *= 0.15f;
-
-        vertices[i] = x;
-        vertices[i + 1] = y;
-        vertices[i + 2] = 0.0f;
-
-        vertices[i + 3] = 1.0f;
-        vertices[i + 4] = 0.0f;
-        vertices[i + 5] = 0.0f;
-
-        vertices[i + 6] = 0.0f;
-        vertices[i + 7] = 1.0f;
+    selectLod(modelView, projection, viewportHeight);
+    draw();
+}
 
-        vertices[i + 8] = 0.0f;
-        vertices[i + 9] = 0.0f;
-        vertices[i + 10] = 0.0f;
+void ShapeMesh::selectLod(const glm::mat4& modelView, const glm::mat4& projection, float viewportHeight, float thresholdPixels)
+{
+    if (lods.empty()) {
+        return;
     }
-
-    primitive = GL_LINES;
-    indices.resize(2 * n);  // points = indices.size() - 1;
-    int k = 0;
-    for (int i = 0; i < indices.size() - 1; i+=2) {
-        indices[i] = k;
-        indices[i + 1] = k + 1;
-        k++;
+    const glm::vec4 centre = modelView * glm::vec4(lodCentre[0], lodCentre[1], lodCentre[2], 1.0f);
+    const float scale = std::max({ glm::length(glm::vec3(modelView[0])), glm::length(glm::vec3(modelView[1])), glm::length(glm::vec3(modelView[2])) });
+
+    // projection[1][1] is cot(fovy / 2); orthographic projections have no divide by distance
+    float pixelsPerUnit = scale * projection[1][1] * 0.5f * viewportHeight;
+    if (projection[2][3] != 0.0f) {
+        const float distance = std::max(-centre.z - scale * lodRadius, 1e-4f); // nearest point of the bounding sphere
+        pixelsPerUnit /= distance;
+    }
+    if (m_morphBuffer) {
+        lodLevel = ::selectLod(lods, pixelsPerUnit, lodLevel, thresholdPixels, 0.0f);
+        lodMorph = lodMorphFactor(lods, lodLevel, pixelsPerUnit, thresholdPixels);
+    }
+    else {
+        lodLevel = ::selectLod(lods, pixelsPerUnit, lodLevel, thresholdPixels);
     }
-
-    setLayout();
 }
 
-ConeMesh::ConeMesh(int n, float r)
+void ShapeMesh::setLayout()
 {
-    //n steps requires n+2 verts including both middles
-    vertices.resize(attribCount * (n + 2));
-    float h = 1.0f;
-
-    vertices[0] = 0.0f;
-    vertices[1] = h;
-    vertices[2] = 0.0f;
-
-    vertices[3] = 0.0f;
-    vertices[4] = 1.0f;
-    vertices[5] = 0.0f;
-
-    vertices[6] = 0.5f;
-    vertices[7] = 0.5f;
-
-    vertices[8] = 0.0f;
-    vertices[9] = 0.0f;
-    vertices[10] = -1.0f;
-
-    for (int i = attribCount, j = 0; i < vertices.size(); i += attribCount, ++j) {
-        vertices[i] = r * cos(j * 2 * std::numbers::pi / n);
-        vertices[i + 1] = -h;
-        vertices[i + 2] = r * sin(j * 2 * std::numbers::pi / n);;
-
-        vertices[i + 3] = rand() / (1.0 * RAND_MAX);
-        vertices[i + 4] = rand() / (1.0 * RAND_MAX);
-        vertices[i + 5] = rand() / (1.0 * RAND_MAX);
-
-        vertices[i + 6] = (vertices[i] / r + 1.0f) * 0.5f;
-        vertices[i + 7] = (vertices[i + 1] / r + 1.0f) * 0.5f;
+    setLayout(vertices, indices);
+}
 
-        vertices[i + 8] = 0.0f;
-        vertices[i + 9] = 0.0f;
-        vertices[i + 10] = -1.0f;
+void ShapeMesh::setLayout(std::span<const GLfloat> vertexData, std::span<const GLuint> indexData)
+{
+    vertexCount = static_cast<GLsizei>(vertexData.size() / attribCount);
+    indexCount = static_cast<GLsizei>(indexData.size());
+
+    std::span<const std::byte> vertexBytes = std::as_bytes(vertexData);
+    PackedVertices packed;
+    if (layout != VertexLayout::Interleaved) {
+        packed = packVertices(vertexData, layout);
+        vertexBytes = packed.bytes;
     }
-
-    //need 3n indices
-    indices.resize(3 * n);
-
-    indices[0] = 0;
-    indices[1] = 1;
-    indices[2] = 2;
-    for (int i = 3; i < indices.size(); i += 3) {
-        indices[i] = 0;
-        indices[i + 1] = indices[i - 1];
-        indices[i + 2] = indices[i - 1] + 1;
+    dequantization = packed.dequantization;
+
+    const IndexType narrowest = smallestIndexType(indexData, allowByteIndices);
+    indexType = toGLType(narrowest);
+    restartIndex = ::restartIndex(narrowest);
+    std::vector<std::byte> packedIndices;
+    std::span<const std::byte> indexBytes = std::as_bytes(indexData);
+    if (narrowest != IndexType::U32) {
+        packedIndices = packIndices(indexData, narrowest);
+        indexBytes = packedIndices;
     }
-    indices[indices.size() - 1] = indices[1];
 
-    setLayout();
+    bind();
+    glBufferData(GL_ARRAY_BUFFER, vertexBytes.size_bytes(), vertexBytes.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexBytes.size_bytes(), indexBytes.data(), GL_STATIC_DRAW);
+    const auto attributes = describeLayout(layout, vertexCount);
+    for (GLuint location = 0; location < attributes.size(); ++location) {
+        const VertexAttribute& attribute = attributes[location];
+        const GLboolean normalized = attribute.type == AttributeType::Float ? GL_FALSE : GL_TRUE;
+        glVertexAttribPointer(location, attribute.components, toGLType(attribute.type), normalized, attribute.stride, (void*)attribute.offset);
+        glEnableVertexAttribArray(location);
+    }
+    unBind();
 }
 
-SphereMesh::SphereMesh(int n, float r)
+MeshOptimizationReport ShapeMesh::optimize(float overdrawThreshold)
 {
-    // n verts for the circle (no middle)
-    // times m+1 for the sphere
-    int m = n;
-    vertices.resize(attribCount * (n * (m + 1)));
-
-    for (int k = 0; k <= m; k++) {
-        for (int i = 0, j = 0; i < attribCount * n; i += attribCount, ++j) {
-            vertices[k * (attribCount * n) + i] = r * cos(j * 2.0f * std::numbers::pi / n) * sin(k * std::numbers::pi / m);
-            vertices[k * (attribCount * n) + i + 1] = r * sin(j * 2.0f * std::numbers::pi / n) * sin(k * std::numbers::pi / m);
-            vertices[k * (attribCount * n) + i + 2] = r * cos(k * std::numbers::pi / m);
-
-            vertices[k * (attribCount * n) + i + 3] = rand() / (1.0 * RAND_MAX);
-            vertices[k * (attribCount * n) + i + 4] = rand() / (1.0 * RAND_MAX);
-            vertices[k * (attribCount * n) + i + 5] = rand() / (1.0 * RAND_MAX);
-
-            vertices[k * (attribCount * n) + i + 6] = (vertices[k * (attribCount * n) + i] / r + 1) * 0.5f;
-            vertices[k * (attribCount * n) + i + 7] = (vertices[k * (attribCount * n) + i + 1] / r + 1) * 0.5f;
-
-            vertices[k * (attribCount * n) + i + 8] = 0.0f;
-            vertices[k * (attribCount * n) + i + 9] = 0.0f;
-            vertices[k * (attribCount * n) + i + 10] = -1.0f;
-        }
+    prefetch();
+    if (primitive != GL_TRIANGLES || indices.empty()) {
+        return {};
     }
-
-    indices.resize(6 * (n+1) * m);
-    for (int j = 0, k = 0; j < m; j++, k+=6) {
-        for (int i = 0; i < n-1; i++, k+=6) {
-            indices[k] = i + (j + 1) * n;;
-            indices[k+1] = i + j * n;
-            indices[k+2] = i + 1 + (j + 1) * n;
-
-            indices[k+3] = i + j * n;
-            indices[k+4] = i + 1 + j * n;
-            indices[k+5] = i + 1 + (j + 1) * n;
-        }
-        indices[k] = n-1 + (j + 1) * n;;
-        indices[k + 1] = n-1 + j * n;
-        indices[k + 2] = (j+1)*n;
-
-        indices[k + 3] = n-1 + j * n;
-        indices[k + 4] = j * n;
-        indices[k + 5] = (j + 1)* n;
+    if (lods.empty()) {
+        const MeshOptimizationReport report = optimizeMesh(vertices, indices, overdrawThreshold);
+        setLayout();
+        return report;
     }
 
-    setLayout();
-}
-
-TorusMesh::TorusMesh(int n, float R) {
-    int m = n;
-    float r = R / 2;
-    vertices.resize(n * m * attribCount);
-
-    for (int j = 0, k = 0; k < m; ++j, ++k) {
-        for (int i = 0; i < attribCount * n; i += attribCount) {
-            int offset = k * attribCount * n;
-            GLfloat A = (r * cos(i * 2.0f * std::numbers::pi / (attribCount * n)) + R) * cos(j * 2.0f * std::numbers::pi / (m));
-            GLfloat B = r * sin(i * 2.0f * std::numbers::pi / (attribCount * n));
-            GLfloat C = (r * cos(i * 2.0f * std::numbers::pi / (attribCount * n)) + R) * sin(j * 2.0f * std::numbers::pi / (m));
-
-            vertices[offset + i] = C;
-            vertices[offset + i + 1] = A;
-            vertices[offset + i + 2] = B;
-
-            vertices[offset + i + 3] = rand() / (1.0 * RAND_MAX);
-            vertices[offset + i + 4] = rand() / (1.0 * RAND_MAX);
-            vertices[offset + i + 5] = rand() / (1.0 * RAND_MAX);
-
-            vertices[offset + i + 6] = 0.0;
-            vertices[offset + i + 7] = 0.0;
-
-            vertices[offset + i + 8] = 0.0;
-            vertices[offset + i + 9] = 0.0;
-            vertices[offset + i + 10] = 0.0;
+    // Triangles may only move within their level; the vertex renumbering spans them all.
+    // The report covers the finest level.
+    const std::size_t totalVertices = vertices.size() / attribCount;
+    MeshOptimizationReport report;
+    for (std::size_t level = 0; level < lods.size(); ++level) {
+        const std::span<GLuint> range(indices.data() + lods[level].firstIndex, lods[level].indexCount);
+        const VertexCacheStats before = analyzeVertexCache(range, totalVertices);
+        optimizeVertexCache(range, totalVertices);
+        if (overdrawThreshold >= 1.0f) {
+            optimizeOverdraw(range, vertices, overdrawThreshold);
         }
-    }
-
-    indices.resize(6 * (n) * (m));
-    int k = 0;
-    for (int j = 0; j < m-1; ++j, k+=6)
-    {
-        for (int i = 0; i < n - 1; ++i, k+=6)
-        {
-            indices[k] = i + (j + 1) * n;
-            indices[k + 1] = i + j * n;
-            indices[k + 2] = i + 1 + (j + 1) * n;
-
-            indices[k + 3] = i + j * n;
-            indices[k + 4] = i + 1 + j * n;
-            indices[k + 5] = i + 1 + (j + 1) * n;
+        if (level == 0) {
+            report.before = before;
         }
-        indices[k] = n - 1 + (j + 1) * n;
-        indices[k + 1] = n - 1 + j * n;
-        indices[k + 2] = (j + 1) * n;
-
-        indices[k + 3] = n - 1 + j * n;
-        indices[k + 4] = j * n;
-        indices[k + 5] = (j + 1) * n;
     }
+    if (!m_morphBuffer) {
+        optimizeVertexFetch(vertices, indices); // would leave the morph targets behind
+    }
+    report.after = analyzeVertexCache(std::span<const GLuint>(indices.data(), lods[0].indexCount), totalVertices);
+    setLayout();
+    return report;
+}
 
-    for (int i = 0; i < n - 1; ++i, k+=6)
-    {
-        indices[k] = m * (n - 1) + i;
-        indices[k + 1] = m * (n - 1) + i + 1;
-        indices[k + 2] = i;
-
-        indices[k + 3] = m * (n - 1) + i + 1;
-        indices[k + 4] = i + 1;
-        indices[k + 5] = i;
+float ShapeMesh::simplify(const SimplifyOptions& options)
+{
+    prefetch();
+    if (primitive != GL_TRIANGLES || indices.empty() || !lods.empty()) {
+        return 0.0f;
     }
+    MeshData data{ std::move(vertices), std::move(indices), Primitive::Triangles };
+    const float error = simplifyMesh(data, options);
+    upload(std::move(data));
+    return error;
+}
 
-    indices[k ] = m*(n-1);
-    indices[k+1] = n*m - 1;
-    indices[k + 2] = 0;
+void ShapeMesh::bind() const
+{
+    vao.bind();
+    vbo.bind();
+    ebo.bind();
+}
 
-    indices[k + 3] = n * m - 1;
-    indices[k + 4] = n-1;
-    indices[k + 5] = 0;
+void ShapeMesh::unBind() const
+{
+    vbo.unBind();
+    vao.unBind();
+    ebo.unBind();
+    // Unbind EBO AFTER unbinding VAO, as the EBO is linked in the VAO
+    // This does not apply to the VBO because the VBO is already linked to the VAO during glVertexAttribPointer
+}
 
-    setLayout();
+CoordinateAxesMesh::CoordinateAxesMesh()
+    : ShapeMesh(generateCoordinateAxes())
+{
 }
 
-StarTorusMesh::StarTorusMesh(int n, float R) {
-    int m = n;
-    float r = R / 2;
-    vertices.resize( n * m * attribCount);
+RectangleMesh::RectangleMesh(GLfloat height, GLfloat width)
+    : ShapeMesh(generateRectangle(height, width))
+{
+}
 
-    int j = 0;
-    for (int j = 0, k = 0; k < m; ++j, ++k) {
-        for (int i = 0; i < attribCount * n; i += attribCount) {
-            int offset = k * attribCount * n;
+CuboidMesh::CuboidMesh(GLfloat width, GLfloat height, GLfloat depth)
+    : ShapeMesh(generateCuboid(width, height, depth))
+{
+}
 
-            GLfloat A = (r * cos(i * 2.0f * std::numbers::pi / n) + R) * cos(j * 2.0f * std::numbers::pi / m);
-            GLfloat B = r * sin(i * 2.0f * std::numbers::pi / n);
-            GLfloat C = (r * cos(i * 2.0f * std::numbers::pi / n) + R) * sin(j * 2.0f * std::numbers::pi / m);
+CircleMesh::CircleMesh(int n, float r, std::uint32_t seed)
+    : ShapeMesh(generateCircle(n, r, seed))
+{
+}
 
-            vertices[offset + i] = C;
-            vertices[offset + i + 1] = A;
-            vertices[offset + i + 2] = B;
+CylinderMesh::CylinderMesh(int n, float r, std::uint32_t seed)
+    : ShapeMesh(generateCylinder(n, r, seed))
+{
+}
 
-            vertices[offset + i + 3] = rand() / (1.0 * RAND_MAX);
-            vertices[offset + i + 4] = rand() / (1.0 * RAND_MAX);
-            vertices[offset + i + 5] = rand() / (1.0 * RAND_MAX);
+PolynomialMesh::PolynomialMesh(float a, float b, float c, float d, float e, float r, float s, float low, float high, int n, bool ySquared)
+    : ShapeMesh(generatePolynomial(a, b, c, d, e, r, s, low, high, n, ySquared))
+{
+}
 
-            vertices[offset + i + 6] = 0.0;
-            vertices[offset + i + 7] = 0.0;
+PolynomialMesh::PolynomialMesh(const Polynomial& polynomial, float low, float high, const PolynomialSampling& sampling)
+    : ShapeMesh(generateAdaptivePolynomial(polynomial, low, high, sampling))
+{
+}
 
-            vertices[offset + i + 8] = 0.0;
-            vertices[offset + i + 9] = 0.0;
-            vertices[offset + i + 10] = 0.0;
-        }
-    }
+ConeMesh::ConeMesh(int n, float r, std::uint32_t seed)
+    : ShapeMesh(generateCone(n, r, seed))
+{
+}
 
-    indices.resize( 6 * (n + 1) * m );
-    for (int j = 0, k = 0; j < m; ++j, k+=6) {
-        for (int i = 0; i < n - 1; ++i, k+=6) {
-            indices[k] = i + (j + 1) * n;;
-            indices[k + 1] = i + j * n;
-            indices[k + 2] = i + 1 + (j + 1) * n;
+SphereMesh::SphereMesh(int n, float r, std::uint32_t seed, const GenerateOptions& options)
+    : ShapeMesh(cleaned(generateSphere(n, r, seed, options))) // welds the rings of coincident pole vertices
+{
+}
 
-            indices[k + 3] = i + j * n;
-            indices[k + 4] = i + 1 + j * n;
-            indices[k + 5] = i + 1 + (j + 1) * n;
-        }
+TorusMesh::TorusMesh(int n, float R, std::uint32_t seed, const GenerateOptions& options)
+    : ShapeMesh(generateTorus(n, R, seed, options))
+{
+}
 
-        indices[k] = n - 1 + (j + 1) * n;;
-        indices[k + 1] = n - 1 + j * n;
-        indices[k + 2] = (j + 1) * n;
+StarTorusMesh::StarTorusMesh(int n, float R, std::uint32_t seed, const GenerateOptions& options)
+    : ShapeMesh(generateStarTorus(n, R, seed, options))
+{
+}
 
-        indices[k + 3] = n - 1 + j * n;
-        indices[k + 4] = j * n;
-        indices[k + 5] = (j + 1) * n;
-    }
-    indices[indices.size() - 1] = indices[1];
+ImplicitSurfaceMesh::ImplicitSurfaceMesh(const ImplicitField& field, const ImplicitSurfaceOptions& options, std::uint32_t seed)
+    : ShapeMesh(generateImplicitSurface(field, options, seed))
+{
+}
 
-    setLayout();
+ImplicitSurfaceMesh::ImplicitSurfaceMesh(const ScalarField& field, const ImplicitSurfaceOptions& options, std::uint32_t seed)
+    : ShapeMesh(generateImplicitSurface(field, options, seed))
+{
 }
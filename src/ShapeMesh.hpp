@@ -8,22 +8,72 @@
 #include "VBO.hpp"
 #include "EBO.hpp"
 #include "Texture.hpp"
+#include "MeshData.hpp"
+#include "MeshGenerators.hpp"
+#include "ImplicitSurface.hpp"
+#include "ParametricSurface.hpp"
+#include "VertexLayout.hpp"
+#include "IndexFormat.hpp"
+#include "MeshOptimizer.hpp"
+#include "MeshSimplifier.hpp"
+#include "LodChain.hpp"
+
+#include "glm/glm.hpp"
 
 #include <cmath>
+#include <cstdint>
+#include <functional>
 #include <limits>
+#include <memory>
 #include <numbers>
+#include <span>
 #include <vector>
 
+GLenum toGLPrimitive(Primitive primitive);
+GLenum toGLType(AttributeType type);
+GLenum toGLType(IndexType type);
+
+// Sets the generic attributes the vertex shaders dequantize with (locations 4 and 5).
+// Every draw must set them: GL's default generic value would scale positions by zero.
+void setDequantization(const Dequantization& dequantization);
+
 class ShapeMesh
 {
 public:
-    void draw() const;
-    void setLayout() const;
+    void draw(); // generates and uploads a deferred mesh first; draws lodLevel when the mesh has LODs
+    void draw(const glm::mat4& modelView, const glm::mat4& projection, float viewportHeight); // selectLod(), then draw()
+    void upload(MeshData data); // replaces vertices/indices and uploads them
+    void setLayout();
+    void setLayout(std::span<const GLfloat> vertexData, std::span<const GLuint> indexData); // uploads interleaved data without keeping a copy in vertices/indices
     void bind() const;
     void unBind() const;
+    // Reorders vertices/indices for the post-transform cache, vertex fetch and, when
+    // overdrawThreshold >= 1, overdraw (see optimizeMesh), then re-uploads.
+    MeshOptimizationReport optimize(float overdrawThreshold = 0.0f);
+    // Collapses edges until options.targetTriangles remain or options.maxError is reached (see
+    // simplifyMesh), then re-uploads. Returns the error. Triangle lists with LODs are left alone.
+    float simplify(const SimplifyOptions& options);
 
 public:
     ShapeMesh() = default;
+    explicit ShapeMesh(MeshData data, VertexLayout vertexLayout = VertexLayout::Interleaved); // uploads immediately, needs a current GL context
+    explicit ShapeMesh(LodChain chain, VertexLayout vertexLayout = VertexLayout::Interleaved); // all levels in the one set of buffers
+
+    // Picks lodLevel from the bounding sphere's projected size: the coarsest level whose
+    // error stays under thresholdPixels, with hysteresis (see ::selectLod). Chains with
+    // morph targets switch without hysteresis and set lodMorph instead.
+    void selectLod(const glm::mat4& modelView, const glm::mat4& projection, float viewportHeight, float thresholdPixels = 1.0f);
+
+    // Records how to build the mesh but generates nothing and leaves the buffers empty
+    // until the first draw() or prefetch().
+    static std::shared_ptr<ShapeMesh> deferred(std::function<MeshData()> generator, VertexLayout vertexLayout = VertexLayout::Interleaved);
+    void prefetch();
+    bool isPending() const;
+
+    // Prefetches pending meshes in order until budgetMs has elapsed (e.g. one slice per
+    // loading-screen frame). Returns how many are still pending.
+    static std::size_t prewarm(std::span<const std::shared_ptr<ShapeMesh>> meshes,
+        double budgetMs = std::numeric_limits<double>::infinity());
 
     std::vector<GLfloat> vertices;
     std::vector<GLuint> indices;
@@ -31,7 +81,23 @@ public:
     VBO vbo;
     EBO ebo;
     int primitive{ GL_TRIANGLES };
-    static constexpr int attribCount = 11; // 11 == 3pos + 3col + 2tex + 3 norm
+    VertexLayout layout{ VertexLayout::Interleaved }; // applied by setLayout(); vertices stay interleaved
+    Dequantization dequantization; // filled in by setLayout() for VertexLayout::Quantized
+    GLsizei vertexCount{ 0 }; // as uploaded
+    GLsizei indexCount{ 0 };
+    GLenum indexType{ GL_UNSIGNED_INT }; // narrowest type that fits, chosen by setLayout()
+    GLuint restartIndex{ MeshData::restartIndex }; // separates strips; the maximum of indexType
+    bool allowByteIndices{ false }; // lets setLayout() pick GL_UNSIGNED_BYTE for meshes under 256 vertices
+    std::vector<LodLevel> lods; // empty unless built from a LodChain
+    std::array<float, 3> lodCentre{ 0.0f, 0.0f, 0.0f };
+    float lodRadius{ 0.0f };
+    int lodLevel{ 0 };
+    float lodMorph{ 0.0f }; // blend towards the morph targets (location 6), passed as generic attribute 7
+    static constexpr int attribCount = MeshData::attribCount;
+
+private:
+    std::function<MeshData()> m_generator;
+    std::unique_ptr<VBO> m_morphBuffer; // only for geomorphing LOD chains
 };
 
 class CoordinateAxesMesh : public ShapeMesh
@@ -55,13 +121,13 @@ public:
 class CircleMesh : public ShapeMesh
 {
 public:
-    CircleMesh(int n, float r = 1.0f);
+    CircleMesh(int n, float r = 1.0f, std::uint32_t seed = 0);
 };
 
 class CylinderMesh : public ShapeMesh
 {
 public:
-    CylinderMesh(int n, float r = 0.8f);
+    CylinderMesh(int n, float r = 0.8f, std::uint32_t seed = 0);
 };
 
 class PolynomialMesh : public ShapeMesh
@@ -69,30 +135,52 @@ class PolynomialMesh : public ShapeMesh
 public:
     // ax^4 + bx^3 + cx^2 + dx + e + r/x + s/x^2    // low < x < high    // n points    // given in y^2
     PolynomialMesh(float a, float b, float c, float d, float e, float r, float s, float low, float high, int n, bool ySquared);
+    PolynomialMesh(const Polynomial& polynomial, float low, float high, const PolynomialSampling& sampling = {}); // adaptive
 };
 
 class ConeMesh : public ShapeMesh
 {
 public:
-    ConeMesh(int n, float r = 1.0f);
+    ConeMesh(int n, float r = 1.0f, std::uint32_t seed = 0);
 };
 
 class SphereMesh : public ShapeMesh
 {
 public:
-    SphereMesh(int n, float r = 1.0f);
+    SphereMesh(int n, float r = 1.0f, std::uint32_t seed = 0, const GenerateOptions& options = {});
 };
 
 class TorusMesh : public ShapeMesh
 {
 public:
-    TorusMesh(int n, float R = 0.5f);
+    TorusMesh(int n, float R = 0.5f, std::uint32_t seed = 0, const GenerateOptions& options = {});
 };
 
 class StarTorusMesh : public ShapeMesh
 {
 public:
-    StarTorusMesh(int n, float R = 0.5f);
+    StarTorusMesh(int n, float R = 0.5f, std::uint32_t seed = 0, const GenerateOptions& options = {});
+};
+
+// Metaballs, gyroids, blended distance fields or any scalar field, polygonised by
+// generateImplicitSurface().
+class ImplicitSurfaceMesh : public ShapeMesh
+{
+public:
+    ImplicitSurfaceMesh(const ImplicitField& field, const ImplicitSurfaceOptions& options = {}, std::uint32_t seed = 0);
+    ImplicitSurfaceMesh(const ScalarField& field, const ImplicitSurfaceOptions& options = {}, std::uint32_t seed = 0);
+};
+
+// Any surface functor on a grid (see ParametricSurface.hpp), e.g.
+// ParametricSurfaceMesh mesh(TorusSurface{ 0.5f, 0.1f }, { 64, 32, true });
+template <typename Surface>
+class ParametricSurfaceMesh : public ShapeMesh
+{
+public:
+    ParametricSurfaceMesh(const Surface& surface, const SurfaceGrid& grid, std::uint32_t seed = 0, const GenerateOptions& options = {})
+        : ShapeMesh(generateParametricSurface(surface, grid, seed, options))
+    {
+    }
 };
 
 #endif // SHAPEMESH_H
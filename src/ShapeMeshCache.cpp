@@ -0,0 +1,175 @@
+#include "ShapeMeshCache.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    void hashCombine(std::size_t& seed, std::size_t value)
+    {
+        seed ^= value + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2);
+    }
+
+    // The same bits for values that compare equal: -0 becomes 0 and every NaN the same NaN.
+    std::uint32_t canonicalBits(float value)
+    {
+        if (std::isnan(value)) {
+            return std::bit_cast<std::uint32_t>(std::numeric_limits<float>::quiet_NaN());
+        }
+        return std::bit_cast<std::uint32_t>(value + 0.0f);
+    }
+}
+
+bool ShapeKey::operator==(const ShapeKey& other) const
+{
+    for (std::size_t d = 0; d < dims.size(); ++d) {
+        if (canonicalBits(dims[d]) != canonicalBits(other.dims[d])) {
+            return false;
+        }
+    }
+    return type == other.type && n == other.n && seed == other.seed && flags == other.flags;
+}
+
+std::size_t ShapeKeyHash::operator()(const ShapeKey& key) const
+{
+    std::size_t seed = static_cast<std::size_t>(key.type);
+    hashCombine(seed, static_cast<std::size_t>(key.n));
+    for (float dim : key.dims) {
+        hashCombine(seed, canonicalBits(dim));
+    }
+    hashCombine(seed, key.seed);
+    hashCombine(seed, key.flags);
+    return seed;
+}
+
+ShapeMeshCache::ShapeMeshCache(std::size_t capacity)
+    : m_capacity(capacity)
+{
+}
+
+std::shared_ptr<ShapeMesh> ShapeMeshCache::get(const ShapeKey& key, const std::function<std::shared_ptr<ShapeMesh>()>& create)
+{
+    if (key.flags & typedFlag) {
+        throw std::invalid_argument("ShapeMeshCache::get: typedFlag is reserved for the typed helpers");
+    }
+    return lookup(key, create);
+}
+
+std::shared_ptr<ShapeMesh> ShapeMeshCache::lookup(const ShapeKey& key, const std::function<std::shared_ptr<ShapeMesh>()>& create)
+{
+    if (auto it = m_entries.find(key); it != m_entries.end()) {
+        ++m_stats.hits;
+        it->second.lastUse = ++m_tick;
+        return it->second.mesh;
+    }
+
+    ++m_stats.misses;
+    auto mesh = create();
+    m_entries.emplace(key, Entry{ mesh, ++m_tick });
+    evictOverCapacity();
+    return mesh;
+}
+
+template <typename Mesh, typename... Args>
+std::shared_ptr<Mesh> ShapeMeshCache::getTyped(const ShapeKey& key, Args... args)
+{
+    ShapeKey typedKey = key;
+    typedKey.flags |= typedFlag; // get() can't store a mesh of another class under it
+    return std::static_pointer_cast<Mesh>(lookup(typedKey, [&] { return std::make_shared<Mesh>(args...); }));
+}
+
+std::shared_ptr<CoordinateAxesMesh> ShapeMeshCache::coordinateAxes()
+{
+    return getTyped<CoordinateAxesMesh>({ ShapeType::CoordinateAxes });
+}
+
+std::shared_ptr<RectangleMesh> ShapeMeshCache::rectangle(GLfloat height, GLfloat width)
+{
+    return getTyped<RectangleMesh>({ ShapeType::Rectangle, 0, { height, width } }, height, width);
+}
+
+std::shared_ptr<CuboidMesh> ShapeMeshCache::cuboid(GLfloat width, GLfloat height, GLfloat depth)
+{
+    return getTyped<CuboidMesh>({ ShapeType::Cuboid, 0, { width, height, depth } }, width, height, depth);
+}
+
+std::shared_ptr<CircleMesh> ShapeMeshCache::circle(int n, float r, std::uint32_t seed)
+{
+    return getTyped<CircleMesh>({ ShapeType::Circle, n, { r }, seed }, n, r, seed);
+}
+
+std::shared_ptr<CylinderMesh> ShapeMeshCache::cylinder(int n, float r, std::uint32_t seed)
+{
+    return getTyped<CylinderMesh>({ ShapeType::Cylinder, n, { r }, seed }, n, r, seed);
+}
+
+std::shared_ptr<ConeMesh> ShapeMeshCache::cone(int n, float r, std::uint32_t seed)
+{
+    return getTyped<ConeMesh>({ ShapeType::Cone, n, { r }, seed }, n, r, seed);
+}
+
+std::shared_ptr<SphereMesh> ShapeMeshCache::sphere(int n, float r, std::uint32_t seed)
+{
+    return getTyped<SphereMesh>({ ShapeType::Sphere, n, { r }, seed }, n, r, seed);
+}
+
+std::shared_ptr<TorusMesh> ShapeMeshCache::torus(int n, float R, std::uint32_t seed)
+{
+    return getTyped<TorusMesh>({ ShapeType::Torus, n, { R }, seed }, n, R, seed);
+}
+
+std::shared_ptr<StarTorusMesh> ShapeMeshCache::starTorus(int n, float R, std::uint32_t seed)
+{
+    return getTyped<StarTorusMesh>({ ShapeType::StarTorus, n, { R }, seed }, n, R, seed);
+}
+
+std::size_t ShapeMeshCache::evictUnused()
+{
+    const std::size_t evicted = std::erase_if(m_entries, [](const auto& item) {
+        return item.second.mesh.use_count() == 1;
+    });
+    m_stats.evictions += evicted;
+    return evicted;
+}
+
+void ShapeMeshCache::clear()
+{
+    m_stats.evictions += m_entries.size();
+    m_entries.clear();
+}
+
+std::size_t ShapeMeshCache::size() const
+{
+    return m_entries.size();
+}
+
+const ShapeMeshCacheStats& ShapeMeshCache::stats() const
+{
+    return m_stats;
+}
+
+void ShapeMeshCache::evictOverCapacity()
+{
+    if (m_entries.size() <= m_capacity) {
+        return;
+    }
+
+    std::vector<std::pair<std::uint64_t, ShapeKey>> unused;
+    for (const auto& [key, entry] : m_entries) {
+        if (entry.mesh.use_count() == 1) {
+            unused.emplace_back(entry.lastUse, key);
+        }
+    }
+    std::sort(unused.begin(), unused.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    for (const auto& [lastUse, key] : unused) {
+        if (m_entries.size() <= m_capacity) {
+            break;
+        }
+        m_entries.erase(key);
+        ++m_stats.evictions;
+    }
+}
@@ -0,0 +1,108 @@
+#ifndef SHAPEMESHCACHE_H
+#define SHAPEMESHCACHE_H
+
+#include "ShapeMesh.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+enum class ShapeType
+{
+    CoordinateAxes,
+    Rectangle,
+    Cuboid,
+    Circle,
+    Cylinder,
+    Cone,
+    Sphere,
+    Torus,
+    StarTorus,
+};
+
+// Everything that affects the generated geometry. dims holds the shape's sizes in
+// constructor order (radius, or width/height/depth); flags is free for callers that
+// build variants of the same shape, apart from ShapeMeshCache::typedFlag. dims compare
+// by value, except that every NaN matches every other, so that equal keys hash alike.
+struct ShapeKey
+{
+    bool operator==(const ShapeKey& other) const;
+
+    ShapeType type;
+    int n{ 0 };
+    std::array<float, 3> dims{};
+    std::uint32_t seed{ 0 };
+    std::uint32_t flags{ 0 };
+};
+
+struct ShapeKeyHash
+{
+    std::size_t operator()(const ShapeKey& key) const;
+};
+
+struct ShapeMeshCacheStats
+{
+    std::size_t hits{ 0 };
+    std::size_t misses{ 0 };
+    std::size_t evictions{ 0 };
+};
+
+// Hands out shared meshes so identical shapes are generated and uploaded once.
+// Entries stay alive while referenced; once only the cache holds one it may be
+// evicted, oldest first, when the cache grows past its capacity or on evictUnused().
+// Owns GL objects, so use it from the GL thread only.
+class ShapeMeshCache
+{
+public:
+    explicit ShapeMeshCache(std::size_t capacity = 256);
+
+    // Set on the keys of the typed helpers below, which cast what they find back to their
+    // class: get() throws std::invalid_argument for keys that set it.
+    static constexpr std::uint32_t typedFlag = 0x80000000u;
+
+    std::shared_ptr<ShapeMesh> get(const ShapeKey& key, const std::function<std::shared_ptr<ShapeMesh>()>& create);
+
+    std::shared_ptr<CoordinateAxesMesh> coordinateAxes();
+    std::shared_ptr<RectangleMesh> rectangle(GLfloat height, GLfloat width);
+    std::shared_ptr<CuboidMesh> cuboid(GLfloat width, GLfloat height, GLfloat depth);
+    std::shared_ptr<CircleMesh> circle(int n, float r = 1.0f, std::uint32_t seed = 0);
+    std::shared_ptr<CylinderMesh> cylinder(int n, float r = 0.8f, std::uint32_t seed = 0);
+    std::shared_ptr<ConeMesh> cone(int n, float r = 1.0f, std::uint32_t seed = 0);
+    std::shared_ptr<SphereMesh> sphere(int n, float r = 1.0f, std::uint32_t seed = 0);
+    std::shared_ptr<TorusMesh> torus(int n, float R = 0.5f, std::uint32_t seed = 0);
+    std::shared_ptr<StarTorusMesh> starTorus(int n, float R = 0.5f, std::uint32_t seed = 0);
+
+    std::size_t evictUnused();
+    void clear();
+
+    std::size_t size() const;
+    const ShapeMeshCacheStats& stats() const;
+
+    ShapeMeshCache(const ShapeMeshCache& other) = delete;
+    ShapeMeshCache& operator=(const ShapeMeshCache& other) = delete;
+    ShapeMeshCache(ShapeMeshCache&& other) = delete;
+    ShapeMeshCache& operator=(ShapeMeshCache&& other) = delete;
+
+private:
+    template <typename Mesh, typename... Args>
+    std::shared_ptr<Mesh> getTyped(const ShapeKey& key, Args... args);
+
+    std::shared_ptr<ShapeMesh> lookup(const ShapeKey& key, const std::function<std::shared_ptr<ShapeMesh>()>& create);
+    void evictOverCapacity();
+
+    struct Entry
+    {
+        std::shared_ptr<ShapeMesh> mesh;
+        std::uint64_t lastUse;
+    };
+
+    std::unordered_map<ShapeKey, Entry, ShapeKeyHash> m_entries;
+    std::size_t m_capacity;
+    std::uint64_t m_tick{ 0 };
+    ShapeMeshCacheStats m_stats;
+};
+
+#endif // SHAPEMESHCACHE_H
@@ -0,0 +1,136 @@
+#include "TessellatedShapes.hpp"
+
+#include "MeshCleanup.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <numbers>
+
+namespace {
+    constexpr std::uint32_t fallbackFlag = 0x7E55; // keeps the cache's procedural entries apart from the generators'
+
+    ShapeType toShapeType(ProceduralKind kind)
+    {
+        switch (kind) {
+        case ProceduralKind::Sphere:
+            return ShapeType::Sphere;
+        case ProceduralKind::Torus:
+            return ShapeType::Torus;
+        case ProceduralKind::Cone:
+            return ShapeType::Cone;
+        default:
+            return ShapeType::Cylinder;
+        }
+    }
+}
+
+TessellatedShapes::TessellatedShapes(bool allowTessellation)
+    : m_fallback(64)
+    , m_tessellated(allowTessellation && tessellationSupported())
+{
+}
+
+bool TessellatedShapes::tessellationSupported()
+{
+    return GLAD_GL_VERSION_4_0 != 0;
+}
+
+bool TessellatedShapes::tessellated() const
+{
+    return m_tessellated;
+}
+
+std::size_t TessellatedShapes::add(const ProceduralInstance& instance)
+{
+    m_instances.push_back(instance);
+    return m_patches.add(instance);
+}
+
+void TessellatedShapes::set(std::size_t index, const ProceduralInstance& instance)
+{
+    m_instances.at(index) = instance;
+    m_patches.set(index, instance);
+}
+
+void TessellatedShapes::clear()
+{
+    m_instances.clear();
+    m_patches.clear();
+    m_drawn.clear();
+}
+
+std::size_t TessellatedShapes::size() const
+{
+    return m_instances.size();
+}
+
+void TessellatedShapes::draw(const Shader& shader, const glm::mat4& model, const glm::mat4& view, const glm::mat4& projection,
+    float viewportWidth, float viewportHeight)
+{
+    shader.setView(view);
+    shader.setProjection(projection);
+    if (!m_tessellated) {
+        drawFallback(shader, model, view, projection, viewportHeight);
+        return;
+    }
+    shader.setModel(model);
+    shader.setTessellation(viewportWidth, viewportHeight, edgePixels);
+    m_patches.drawPatches();
+}
+
+// Picks the resolution whose edges come closest to edgePixels around the shape's widest
+// ring, measured at the nearest point of its bounding sphere as ShapeMesh::selectLod does.
+void TessellatedShapes::drawFallback(const Shader& shader, const glm::mat4& model, const glm::mat4& view,
+    const glm::mat4& projection, float viewportHeight)
+{
+    const glm::mat4 modelView = view * model;
+    const float scale = std::max({ glm::length(glm::vec3(modelView[0])), glm::length(glm::vec3(modelView[1])), glm::length(glm::vec3(modelView[2])) });
+    std::vector<std::shared_ptr<ShapeMesh>> drawn;
+    drawn.reserve(m_instances.size());
+
+    for (const ProceduralInstance& instance : m_instances) {
+        const glm::vec3 position(instance.position[0], instance.position[1], instance.position[2]);
+        const float radius = proceduralBoundingRadius(instance);
+        float pixelsPerUnit = scale * projection[1][1] * 0.5f * viewportHeight;
+        if (projection[2][3] != 0.0f) {
+            const glm::vec4 centre = modelView * glm::vec4(position, 1.0f);
+            pixelsPerUnit /= std::max(-centre.z - scale * radius, 1e-4f);
+        }
+        const float columns = 2.0f * std::numbers::pi_v<float> * radius * pixelsPerUnit / std::max(edgePixels, 1.0f);
+        const int n = std::clamp(int(std::bit_ceil(unsigned(std::max(columns, 1.0f)))), minResolution, maxResolution);
+
+        ProceduralInstance shape = instance;
+        shape.columns = std::uint32_t(n);
+        if (instance.kind == ProceduralKind::Sphere || instance.kind == ProceduralKind::Torus) {
+            shape.rows = std::uint32_t(n);
+        }
+        shape.position[0] = shape.position[1] = shape.position[2] = 0.0f;
+
+        // Meshes are generated at unit scale (radius for spheres, size for the rest) and scaled
+        // by the model matrix, so shapes that differ only in size share one.
+        const float unit = shape.kind == ProceduralKind::Sphere ? shape.radius : shape.size;
+        if (unit > 0.0f) {
+            shape.radius /= unit;
+            shape.size /= unit;
+        }
+        const ShapeKey key{ toShapeType(shape.kind), n, { shape.radius, shape.size, float(shape.rows) }, shape.seed, fallbackFlag };
+        const std::shared_ptr<ShapeMesh> mesh = m_fallback.get(key, [&] {
+            MeshData data = generateProcedural(shape);
+            cleanMesh(data); // welds the quads' shared corners into an indexed mesh
+            return std::make_shared<ShapeMesh>(std::move(data));
+        });
+
+        glm::mat4 placed = model;
+        placed[3] = model * glm::vec4(position, 1.0f);
+        if (unit > 0.0f) {
+            placed[0] *= unit;
+            placed[1] *= unit;
+            placed[2] *= unit;
+        }
+        shader.setModel(placed);
+        mesh->draw();
+        drawn.push_back(mesh);
+    }
+    m_drawn = std::move(drawn);
+}
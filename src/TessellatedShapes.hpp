@@ -0,0 +1,64 @@
+#ifndef TESSELLATEDSHAPES_H
+#define TESSELLATEDSHAPES_H
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "ProceduralShapeBatch.hpp"
+#include "ShapeMeshCache.hpp"
+#include "Shader.hpp"
+
+#include "glm/glm.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Spheres, tori, cones and cylinders whose triangle density follows their size on screen.
+// With GL 4.0 each shape is a coarse grid of patches (instance.columns x instance.rows,
+// e.g. proceduralSphere(8)): the control shader sets every edge's tessellation level from
+// its projected length and the evaluation shader puts each vertex on the analytic surface,
+// so no dense mesh is stored. Draw with tessellated.vert/.tesc/.tese and default.frag.
+//
+// Without tessellation each shape is a cached ShapeMesh of generateProcedural() at the
+// smallest power-of-two resolution that meets the same target, drawn with default.vert/.frag.
+// Meshes are cached at unit scale, so shapes that differ only in size share one; those
+// drawn last frame are never evicted, so large scenes do not regenerate every frame.
+class TessellatedShapes
+{
+public:
+    explicit TessellatedShapes(bool allowTessellation = true);
+
+    static bool tessellationSupported(); // needs a current context
+    bool tessellated() const;            // which shaders draw() expects
+
+    std::size_t add(const ProceduralInstance& instance); // returns the instance's index
+    void set(std::size_t index, const ProceduralInstance& instance);
+    void clear();
+    std::size_t size() const;
+
+    // Sets the matrices (and tessellation uniforms) on shader, which must be in use.
+    void draw(const Shader& shader, const glm::mat4& model, const glm::mat4& view, const glm::mat4& projection,
+        float viewportWidth, float viewportHeight);
+
+    float edgePixels{ 8.0f }; // screen length triangle edges aim for
+    int minResolution{ 8 };   // fallback columns range
+    int maxResolution{ 256 };
+
+    TessellatedShapes(const TessellatedShapes& other) = delete;
+    TessellatedShapes& operator=(const TessellatedShapes& other) = delete;
+    TessellatedShapes(TessellatedShapes&& other) = delete;
+    TessellatedShapes& operator=(TessellatedShapes&& other) = delete;
+
+private:
+    void drawFallback(const Shader& shader, const glm::mat4& model, const glm::mat4& view, const glm::mat4& projection,
+        float viewportHeight);
+
+    std::vector<ProceduralInstance> m_instances;
+    ProceduralShapeBatch m_patches;
+    ShapeMeshCache m_fallback;
+    std::vector<std::shared_ptr<ShapeMesh>> m_drawn; // the last fallback draw's meshes, kept from eviction
+    bool m_tessellated;
+};
+
+#endif // TESSELLATEDSHAPES_H
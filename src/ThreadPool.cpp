@@ -0,0 +1,107 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+ThreadPool::ThreadPool(unsigned threads)
+{
+    threads = std::max(1u, threads);
+    m_workers.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) {
+        m_workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    m_wake.notify_one();
+}
+
+unsigned ThreadPool::size() const
+{
+    return static_cast<unsigned>(m_workers.size());
+}
+
+void ThreadPool::parallelFor(std::size_t count, std::size_t grain, unsigned maxThreads,
+    const std::function<void(std::size_t, std::size_t)>& fn)
+{
+    grain = std::max<std::size_t>(1, grain);
+    const std::size_t chunks = (count + grain - 1) / grain;
+    const unsigned helpers = static_cast<unsigned>(std::min<std::size_t>({ chunks, maxThreads, size() + 1 })) - 1;
+
+    if (chunks <= 1 || helpers == 0) {
+        if (count > 0) {
+            fn(0, count);
+        }
+        return;
+    }
+
+    // Shared so helpers that only get scheduled after we return still see valid state.
+    struct State
+    {
+        std::atomic<std::size_t> next{ 0 };
+        std::atomic<std::size_t> done{ 0 };
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    auto state = std::make_shared<State>();
+
+    auto run = [state, chunks, grain, count, &fn] {
+        for (std::size_t chunk; (chunk = state->next.fetch_add(1)) < chunks;) {
+            const std::size_t begin = chunk * grain;
+            fn(begin, std::min(count, begin + grain));
+            if (state->done.fetch_add(1) + 1 == chunks) {
+                std::lock_guard lock(state->mutex);
+                state->finished.notify_all();
+            }
+        }
+    };
+
+    for (unsigned i = 0; i < helpers; ++i) {
+        submit(run);
+    }
+    run();
+
+    std::unique_lock lock(state->mutex);
+    state->finished.wait(lock, [&] { return state->done.load() == chunks; });
+}
+
+ThreadPool& ThreadPool::shared()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::workerLoop()
+{
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+            if (m_stopping && m_tasks.empty()) {
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+public:
+    explicit ThreadPool(unsigned threads = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    void submit(std::function<void()> task);
+
+    unsigned size() const;
+
+    // Splits [0, count) into chunks of at least grain items and runs fn(begin, end) on up to
+    // maxThreads threads, the calling thread included. The caller keeps pulling chunks itself,
+    // so this is safe to call from inside a pool task and never waits on queued work.
+    void parallelFor(std::size_t count, std::size_t grain, unsigned maxThreads,
+        const std::function<void(std::size_t, std::size_t)>& fn);
+
+    // Process-wide pool sized to the hardware, used by the mesh generators.
+    static ThreadPool& shared();
+
+    ThreadPool(const ThreadPool& other) = delete;
+    ThreadPool& operator=(const ThreadPool& other) = delete;
+    ThreadPool(ThreadPool&& other) = delete;
+    ThreadPool& operator=(ThreadPool&& other) = delete;
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> m_workers;
+    std::deque<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_stopping{ false };
+};
+
+#endif // THREADPOOL_H
@@ -21,6 +21,11 @@ public:
         glBindBuffer(GL_ARRAY_BUFFER, 0); 
     }
 
+    GLuint id() const
+    {
+        return buffer;
+    }
+
     ~VBO()
     {
         glDeleteBuffers(1, &buffer);
@@ -0,0 +1,167 @@
+#include "VertexLayout.hpp"
+#include "MeshData.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace {
+    constexpr int attribCount = MeshData::attribCount;
+    constexpr int components[4] = { 3, 3, 2, 3 };
+    constexpr int interleavedOffset[4] = { 0, 3, 6, 8 }; // floats into an interleaved vertex
+
+    struct QuantizedVertex
+    {
+        std::int16_t position[4]; // w is padding
+        std::uint8_t colour[4];
+        std::uint16_t texture[2];
+        std::int16_t normal[2];
+    };
+    static_assert(sizeof(QuantizedVertex) == 20);
+
+    std::int16_t toSnorm16(float value)
+    {
+        return static_cast<std::int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+    }
+
+    std::uint16_t toUnorm16(float value)
+    {
+        return static_cast<std::uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+    }
+
+    std::uint8_t toUnorm8(float value)
+    {
+        return static_cast<std::uint8_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+    }
+
+    float signNotZero(float value)
+    {
+        return value < 0.0f ? -1.0f : 1.0f;
+    }
+
+    // Projects the unit sphere onto an octahedron and unfolds the lower half over the
+    // corners of the [-1, 1] square.
+    std::array<float, 2> octahedralEncode(const float* normal)
+    {
+        const float l1 = std::abs(normal[0]) + std::abs(normal[1]) + std::abs(normal[2]);
+        if (l1 == 0.0f) {
+            return { 0.0f, 0.0f };
+        }
+        const float x = normal[0] / l1;
+        const float y = normal[1] / l1;
+        if (normal[2] >= 0.0f) {
+            return { x, y };
+        }
+        return { (1.0f - std::abs(y)) * signNotZero(x), (1.0f - std::abs(x)) * signNotZero(y) };
+    }
+
+    PackedVertices quantize(std::span<const float> interleaved)
+    {
+        const std::size_t vertexCount = interleaved.size() / attribCount;
+
+        std::array<float, 3> low, high;
+        low.fill(std::numeric_limits<float>::max());
+        high.fill(std::numeric_limits<float>::lowest());
+        for (std::size_t v = 0; v < vertexCount; ++v) {
+            const float* position = interleaved.data() + v * attribCount;
+            for (int c = 0; c < 3; ++c) {
+                low[c] = std::min(low[c], position[c]);
+                high[c] = std::max(high[c], position[c]);
+            }
+        }
+
+        PackedVertices packed;
+        Dequantization& dequantization = packed.dequantization;
+        dequantization.octahedralNormals = true;
+        for (int c = 0; c < 3 && vertexCount > 0; ++c) {
+            dequantization.bias[c] = 0.5f * (low[c] + high[c]);
+            const float halfExtent = 0.5f * (high[c] - low[c]);
+            dequantization.scale[c] = halfExtent > 0.0f ? halfExtent : 1.0f;
+        }
+
+        packed.bytes.resize(vertexCount * sizeof(QuantizedVertex));
+        std::byte* out = packed.bytes.data();
+        for (std::size_t v = 0; v < vertexCount; ++v, out += sizeof(QuantizedVertex)) {
+            const float* in = interleaved.data() + v * attribCount;
+            QuantizedVertex vertex{};
+            for (int c = 0; c < 3; ++c) {
+                vertex.position[c] = toSnorm16((in[c] - dequantization.bias[c]) / dequantization.scale[c]);
+                vertex.colour[c] = toUnorm8(in[3 + c]);
+            }
+            vertex.colour[3] = 255;
+            vertex.texture[0] = toUnorm16(in[6]);
+            vertex.texture[1] = toUnorm16(in[7]);
+            const auto normal = octahedralEncode(in + 8);
+            vertex.normal[0] = toSnorm16(normal[0]);
+            vertex.normal[1] = toSnorm16(normal[1]);
+            std::memcpy(out, &vertex, sizeof(vertex));
+        }
+        return packed;
+    }
+}
+
+std::array<VertexAttribute, 4> describeLayout(VertexLayout layout, std::size_t vertexCount)
+{
+    std::array<VertexAttribute, 4> attributes{};
+    switch (layout) {
+    case VertexLayout::Interleaved:
+        for (int a = 0; a < 4; ++a) {
+            attributes[a] = { components[a], interleavedOffset[a] * sizeof(float), attribCount * sizeof(float) };
+        }
+        break;
+    case VertexLayout::SplitPosition: {
+        constexpr int restCount = attribCount - 3;
+        attributes[0] = { 3, 0, 3 * sizeof(float) };
+        for (int a = 1; a < 4; ++a) {
+            attributes[a] = { components[a], (3 * vertexCount + interleavedOffset[a] - 3) * sizeof(float), restCount * sizeof(float) };
+        }
+        break;
+    }
+    case VertexLayout::Planar:
+        for (int a = 0; a < 4; ++a) {
+            attributes[a] = { components[a], interleavedOffset[a] * vertexCount * sizeof(float), components[a] * static_cast<int>(sizeof(float)) };
+        }
+        break;
+    case VertexLayout::Quantized: {
+        constexpr int stride = sizeof(QuantizedVertex);
+        attributes[0] = { 3, offsetof(QuantizedVertex, position), stride, AttributeType::Snorm16 };
+        attributes[1] = { 4, offsetof(QuantizedVertex, colour), stride, AttributeType::Unorm8 };
+        attributes[2] = { 2, offsetof(QuantizedVertex, texture), stride, AttributeType::Unorm16 };
+        attributes[3] = { 2, offsetof(QuantizedVertex, normal), stride, AttributeType::Snorm16 };
+        break;
+    }
+    }
+    return attributes;
+}
+
+std::size_t vertexSize(VertexLayout layout)
+{
+    return layout == VertexLayout::Quantized ? sizeof(QuantizedVertex) : attribCount * sizeof(float);
+}
+
+PackedVertices packVertices(std::span<const float> interleaved, VertexLayout layout)
+{
+    if (layout == VertexLayout::Quantized) {
+        return quantize(interleaved);
+    }
+
+    PackedVertices packed;
+    packed.bytes.resize(interleaved.size_bytes());
+    if (layout == VertexLayout::Interleaved) {
+        std::memcpy(packed.bytes.data(), interleaved.data(), interleaved.size_bytes());
+        return packed;
+    }
+
+    const std::size_t vertexCount = interleaved.size() / attribCount;
+    const auto attributes = describeLayout(layout, vertexCount);
+    for (int a = 0; a < 4; ++a) {
+        std::byte* out = packed.bytes.data() + attributes[a].offset;
+        const float* in = interleaved.data() + interleavedOffset[a];
+        for (std::size_t v = 0; v < vertexCount; ++v, out += attributes[a].stride, in += attribCount) {
+            std::memcpy(out, in, components[a] * sizeof(float));
+        }
+    }
+    return packed;
+}
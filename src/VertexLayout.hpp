@@ -0,0 +1,61 @@
+#ifndef VERTEXLAYOUT_H
+#define VERTEXLAYOUT_H
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// How a mesh's attributes are arranged in its vertex buffer. Generators always
+// produce Interleaved data; the other layouts are repacked at upload time.
+enum class VertexLayout
+{
+    Interleaved,    // pos col tex nor | pos col tex nor | ...
+    SplitPosition,  // all positions, then col tex nor interleaved: position-only passes fetch 12 bytes/vertex
+    Planar,         // one tightly packed block per attribute
+    Quantized,      // interleaved 20 bytes/vertex: snorm16 pos (against the mesh bounds), rgba8 col, unorm16 tex, octahedral snorm16 nor
+};
+
+enum class AttributeType
+{
+    Float,
+    Snorm16,
+    Unorm16,
+    Unorm8,
+};
+
+// Byte offset of the attribute's first element and the stride between elements.
+// Integer types are always read as normalized values.
+struct VertexAttribute
+{
+    int components;
+    std::size_t offset;
+    int stride;
+    AttributeType type{ AttributeType::Float };
+};
+
+// Maps what the vertex buffer stores back to object space in the vertex shader:
+// position = stored * scale + bias, and normals are octahedral-decoded when asked.
+// The defaults leave float layouts untouched.
+struct Dequantization
+{
+    std::array<float, 3> scale{ 1.0f, 1.0f, 1.0f };
+    std::array<float, 3> bias{ 0.0f, 0.0f, 0.0f };
+    bool octahedralNormals{ false };
+};
+
+struct PackedVertices
+{
+    std::vector<std::byte> bytes;
+    Dequantization dequantization;
+};
+
+// Positions, colours, texture coordinates, normals (shader locations 0-3).
+std::array<VertexAttribute, 4> describeLayout(VertexLayout layout, std::size_t vertexCount);
+std::size_t vertexSize(VertexLayout layout); // bytes per vertex
+
+// Repacks MeshData::attribCount-wide interleaved vertices into the layout's order.
+// Quantized clamps texture coordinates to [0, 1] and decodes zero normals as +z.
+PackedVertices packVertices(std::span<const float> interleaved, VertexLayout layout);
+
+#endif // VERTEXLAYOUT_H
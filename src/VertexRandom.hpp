@@ -0,0 +1,28 @@
+#ifndef VERTEXRANDOM_H
+#define VERTEXRANDOM_H
+
+#include <cstdint>
+
+// Counter-based random numbers for vertex colours. Each value is a pure function of
+// (seed, vertex, channel), so there is no shared state to lock, the loops that use it
+// vectorise, and the same seed gives the same mesh on any thread count or run.
+
+constexpr std::uint32_t hashVertex(std::uint32_t seed, std::uint32_t vertex, std::uint32_t channel)
+{
+    // lowbias32 finaliser over a Weyl-sequence counter
+    std::uint32_t x = (vertex * 4u + channel) * 0x9E3779B9u + seed * 0x85EBCA6Bu;
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return x;
+}
+
+// Uniform in [0, 1).
+constexpr float vertexRandom(std::uint32_t seed, std::uint32_t vertex, std::uint32_t channel)
+{
+    return static_cast<float>(hashVertex(seed, vertex, channel) >> 8) * (1.0f / 16777216.0f);
+}
+
+#endif // VERTEXRANDOM_H
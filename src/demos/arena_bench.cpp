@@ -0,0 +1,145 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "glm/glm.hpp"
+
+#include "MeshArena.hpp"
+#include "ShapeMesh.hpp"
+#include "Shader.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+// A scene of mixed shapes drawn as one ShapeMesh each against one MeshArena per layout:
+//  check: the pixels that differ between the two should be none (run it under a software
+//         renderer, e.g. LIBGL_ALWAYS_SOFTWARE=1, to validate without a GPU)
+//  bench: wall-clock per frame, glFinish included, for growing shape counts
+// Each ShapeMesh draw rebinds its VAO and buffers; the arena binds once per frame.
+
+namespace {
+    constexpr int size = 256;
+    constexpr int frames = 20;
+
+    std::vector<unsigned char> readPixels()
+    {
+        std::vector<unsigned char> pixels(size * size * 4);
+        glReadPixels(0, 0, size, size, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        return pixels;
+    }
+
+    MeshData shapeData(int shape)
+    {
+        const int n = 8 + shape % 24;
+        const auto seed = static_cast<std::uint32_t>(shape);
+        switch (shape % 5) {
+        case 0: return generateSphere(n, 0.4f, seed);
+        case 1: return generateTorus(n, 0.3f, seed);
+        case 2: return generateCone(n, 0.4f, seed);
+        case 3: return generateCylinder(n, 0.4f, seed);
+        default: return generateStarTorus(n, 0.3f, seed);
+        }
+    }
+
+    glm::mat4 modelOf(int shape)
+    {
+        glm::mat4 model(1.0f);
+        model[3] = glm::vec4(float(shape % 32 - 16), float(shape / 32 % 32 - 16), 0.0f, 1.0f);
+        return model;
+    }
+
+    template <typename Draw>
+    double frameMs(Draw draw)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            draw();
+            glFinish();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+    }
+}
+
+int main()
+{
+    glfwInit();
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    GLFWwindow* window = glfwCreateWindow(size, size, "arena bench", NULL, NULL);
+    if (window == NULL)
+    {
+        std::printf("Failed to create GLFW window\n");
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+    gladLoadGL();
+    glViewport(0, 0, size, size);
+    glEnable(GL_DEPTH_TEST);
+
+    {
+        Shader shader("../src/shaders/default.vert", "../src/shaders/default.frag");
+        shader.use();
+        glm::mat4 view(1.0f / 16.0f);
+        view[3][3] = 1.0f;
+        shader.setView(view);
+        shader.setProjection(glm::mat4(1.0f));
+        shader.setMixer(0.0f);
+
+        std::printf("%10s %8s %12s %12s %12s %14s\n", "layout", "shapes", "mesh ms", "arena ms", "build ms", "pixels differ");
+        for (VertexLayout layout : { VertexLayout::Interleaved, VertexLayout::Quantized }) {
+            for (int count : { 10, 100, 1000 }) {
+                std::vector<std::unique_ptr<ShapeMesh>> meshes;
+                for (int shape = 0; shape < count; ++shape) {
+                    meshes.push_back(std::make_unique<ShapeMesh>(shapeData(shape), layout));
+                }
+                auto start = std::chrono::steady_clock::now();
+                MeshArena arena(layout);
+                std::vector<ArenaMesh> ranges;
+                for (int shape = 0; shape < count; ++shape) {
+                    ranges.push_back(arena.add(shapeData(shape)));
+                }
+                const double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+                auto drawMeshes = [&] {
+                    for (int shape = 0; shape < count; ++shape) {
+                        shader.setModel(modelOf(shape));
+                        meshes[shape]->draw();
+                    }
+                };
+                auto drawArena = [&] {
+                    arena.bind();
+                    for (int shape = 0; shape < count; ++shape) {
+                        shader.setModel(modelOf(shape));
+                        arena.draw(ranges[shape]);
+                    }
+                    arena.unBind();
+                };
+
+                const double meshMs = frameMs(drawMeshes);
+                const std::vector<unsigned char> expected = readPixels();
+                const double arenaMs = frameMs(drawArena);
+                const std::vector<unsigned char> actual = readPixels();
+
+                int differ = 0;
+                for (std::size_t p = 0; p < expected.size(); p += 4) {
+                    if (std::abs(expected[p] - actual[p]) + std::abs(expected[p + 1] - actual[p + 1]) + std::abs(expected[p + 2] - actual[p + 2]) > 0) {
+                        ++differ;
+                    }
+                }
+                std::printf("%10s %8d %12.3f %12.3f %12.3f %14d\n", layout == VertexLayout::Interleaved ? "float" : "quantized",
+                    count, meshMs, arenaMs, buildMs, differ);
+            }
+        }
+    }
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return 0;
+}
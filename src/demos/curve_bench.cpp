@@ -0,0 +1,97 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "glm/glm.hpp"
+
+#include "PolynomialCurves.hpp"
+#include "ShapeMesh.hpp"
+#include "Shader.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+// Animates curves whose coefficients change every frame, two ways:
+//  mesh: a new PolynomialMesh per curve per frame (generate, new buffers, upload, draw)
+//  gpu:  one PolynomialCurves batch, set() per curve and a single instanced draw
+// Times are wall-clock per frame, glFinish included.
+
+namespace {
+    constexpr int frames = 20;
+    constexpr int samples = 256;
+
+    Polynomial animated(int curve, int frame)
+    {
+        const float t = 0.05f * frame + 0.01f * curve;
+        return { 0.01f * std::sin(t), 0.0f, -0.2f, std::cos(t), 0.5f * std::sin(0.5f * t), 0.2f * std::cos(t), 0.0f, false };
+    }
+}
+
+int main()
+{
+    glfwInit();
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    GLFWwindow* window = glfwCreateWindow(1024, 1024, "curve bench", NULL, NULL);
+    if (window == NULL)
+    {
+        std::printf("Failed to create GLFW window\n");
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+    gladLoadGL();
+    glViewport(0, 0, 1024, 1024);
+
+    Shader flatShader("../src/shaders/flat.vert", "../src/shaders/flat.frag");
+    Shader curveShader("../src/shaders/curve.vert", "../src/shaders/curve.frag");
+    for (const Shader* shader : { &flatShader, &curveShader }) {
+        shader->use();
+        shader->setModel(glm::mat4(1.0f));
+        shader->setView(glm::mat4(1.0f));
+        shader->setProjection(glm::mat4(1.0f));
+    }
+
+    std::printf("%8s %12s %12s\n", "curves", "mesh ms", "gpu ms");
+    for (int count : { 10, 100, 1000, 5000 }) {
+        auto start = std::chrono::steady_clock::now();
+        flatShader.use();
+        for (int frame = 0; frame < frames; ++frame) {
+            glClear(GL_COLOR_BUFFER_BIT);
+            for (int curve = 0; curve < count; ++curve) {
+                const Polynomial p = animated(curve, frame);
+                PolynomialMesh mesh(p.a, p.b, p.c, p.d, p.e, p.r, p.s, -6.0f, 6.0f, samples, p.ySquared);
+                mesh.draw();
+            }
+            glFinish();
+        }
+        const double meshMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+
+        PolynomialCurves curves(samples);
+        for (int curve = 0; curve < count; ++curve) {
+            curves.add(animated(curve, 0), -6.0f, 6.0f);
+        }
+        start = std::chrono::steady_clock::now();
+        curveShader.use();
+        for (int frame = 0; frame < frames; ++frame) {
+            glClear(GL_COLOR_BUFFER_BIT);
+            for (int curve = 0; curve < count; ++curve) {
+                curves.set(curve, animated(curve, frame), -6.0f, 6.0f);
+            }
+            curves.draw();
+            glFinish();
+        }
+        const double gpuMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+
+        std::printf("%8d %12.3f %12.3f\n", count, meshMs, gpuMs);
+    }
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "IndexFormat.hpp"
+#include "MeshGenerators.hpp"
+#include "ShapeMesh.hpp"
+#include "Shader.hpp"
+#include "VertexLayout.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <utility>
+
+// Compares vertex layouts, and triangle lists with restart-separated strips, for spheres and
+// tori of increasing n:
+//  cpu: time to generate the mesh and repack it into the layout
+//  vbo: size of the uploaded vertex buffer
+//  ebo: size of the uploaded index buffer (after narrowing)
+//  gpu: GL_TIME_ELAPSED for a position-only (depth) pass drawn several times
+
+namespace {
+    constexpr int passes = 20;
+
+    const char* layoutName(VertexLayout layout)
+    {
+        switch (layout) {
+        case VertexLayout::Interleaved: return "interleaved";
+        case VertexLayout::SplitPosition: return "split-position";
+        case VertexLayout::Quantized: return "quantized";
+        default: return "planar";
+        }
+    }
+
+    double elapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main()
+{
+    glfwInit();
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    GLFWwindow* window = glfwCreateWindow(1024, 1024, "layout bench", NULL, NULL);
+    if (window == NULL)
+    {
+        std::printf("Failed to create GLFW window\n");
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+    gladLoadGL();
+
+    Shader depthShader("../src/shaders/depth.vert", "../src/shaders/depth.frag");
+    depthShader.use();
+    depthShader.setModel(glm::mat4(1.0f));
+    depthShader.setView(glm::lookAt(glm::vec3(0.0f, 0.0f, 3.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+    depthShader.setProjection(glm::perspective(glm::radians(45.0f), 1.0f, 0.1f, 100.0f));
+
+    glEnable(GL_DEPTH_TEST);
+    glViewport(0, 0, 1024, 1024);
+    GLuint query;
+    glGenQueries(1, &query);
+
+    const std::pair<const char*, std::function<MeshData(int, const GenerateOptions&)>> shapes[] = {
+        { "sphere", [](int n, const GenerateOptions& options) { return generateSphere(n, 1.0f, 0, options); } },
+        { "torus", [](int n, const GenerateOptions& options) { return generateTorus(n, 0.5f, 0, options); } },
+    };
+
+    std::printf("%-8s %6s %-16s %-6s %10s %10s %10s %10s\n", "shape", "n", "layout", "mode", "cpu ms", "vbo MB", "ebo MB", "gpu ms");
+    for (const auto& [name, generate] : shapes) {
+        for (int n : { 64, 256, 1024, 2048 }) {
+            for (VertexLayout layout : { VertexLayout::Interleaved, VertexLayout::SplitPosition, VertexLayout::Planar, VertexLayout::Quantized }) {
+                for (bool strips : { false, true }) {
+                    GenerateOptions options;
+                    options.triangleStrips = strips;
+                    auto start = std::chrono::steady_clock::now();
+                    MeshData data = generate(n, options);
+                    const auto packed = packVertices(data.vertices, layout);
+                    const double cpuMs = elapsedMs(start);
+                    const double vboMb = packed.bytes.size() / (1024.0 * 1024.0);
+
+                    ShapeMesh mesh(std::move(data), layout);
+                    const double eboMb = mesh.indexCount * indexSize(smallestIndexType(mesh.indices)) / (1024.0 * 1024.0);
+                    glClear(GL_DEPTH_BUFFER_BIT);
+                    glFinish();
+
+                    glBeginQuery(GL_TIME_ELAPSED, query);
+                    for (int pass = 0; pass < passes; ++pass) {
+                        mesh.draw();
+                    }
+                    glEndQuery(GL_TIME_ELAPSED);
+                    GLuint64 gpuNs = 0;
+                    glGetQueryObjectui64v(query, GL_QUERY_RESULT, &gpuNs);
+
+                    std::printf("%-8s %6d %-16s %-6s %10.2f %10.1f %10.2f %10.3f\n", name, n, layoutName(layout), strips ? "strip" : "list",
+                        cpuMs, vboMb, eboMb, gpuNs / 1e6 / passes);
+                }
+            }
+        }
+    }
+
+    glDeleteQueries(1, &query);
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include "ImplicitSurface.hpp"
+#include "MeshGenerators.hpp"
+#include "MeshOptimizer.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <utility>
+
+// Headless: reports post-transform cache efficiency (ACMR/ATVR) and overdraw of the
+// generated shapes before and after optimizeMesh(), and how long the optimisation took.
+
+namespace {
+    constexpr float overdrawThreshold = 1.05f;
+
+    double elapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main()
+{
+    const std::pair<const char*, std::function<MeshData(int)>> shapes[] = {
+        { "circle", [](int n) { return generateCircle(n * 8); } },
+        { "cylinder", [](int n) { return generateCylinder(n * 8); } },
+        { "cone", [](int n) { return generateCone(n * 8); } },
+        { "sphere", [](int n) { return generateSphere(n); } },
+        { "torus", [](int n) { return generateTorus(n); } },
+        { "startorus", [](int n) { return generateStarTorus(n); } },
+        { "metaballs", [](int n) {
+            const ImplicitField field{ { implicitSphere(-0.5f, 0.0f, 0.0f, 0.5f), implicitSphere(0.5f, 0.0f, 0.0f, 0.5f),
+                implicitSphere(0.0f, 0.6f, 0.0f, 0.4f) }, 0.3f };
+            ImplicitSurfaceOptions options;
+            options.resolution = n / 4;
+            return generateImplicitSurface(field, options);
+        } },
+    };
+
+    std::printf("%-10s %6s %10s %8s %8s %8s %8s %8s %8s %10s\n", "shape", "n", "triangles",
+        "acmr", "atvr", "overdraw", "acmr'", "atvr'", "overdraw'", "opt ms");
+    for (const auto& [name, generate] : shapes) {
+        for (int n : { 32, 256, 1024 }) {
+            MeshData mesh = generate(n);
+            const OverdrawStats overdrawBefore = analyzeOverdraw(mesh.indices, mesh.vertices);
+
+            const auto start = std::chrono::steady_clock::now();
+            const MeshOptimizationReport report = optimizeMesh(mesh, overdrawThreshold);
+            const double ms = elapsedMs(start);
+
+            const OverdrawStats overdrawAfter = analyzeOverdraw(mesh.indices, mesh.vertices);
+            std::printf("%-10s %6d %10zu %8.3f %8.3f %8.3f %8.3f %8.3f %8.3f %10.2f\n", name, n, mesh.indices.size() / 3,
+                report.before.acmr, report.before.atvr, overdrawBefore.overdraw,
+                report.after.acmr, report.after.atvr, overdrawAfter.overdraw, ms);
+        }
+    }
+    return 0;
+}
@@ -8,6 +8,7 @@
 #include "MatrixStack.hpp"
 #include "Texture.hpp"
 #include "ShapeMesh.hpp"
+#include "ShapeMeshCache.hpp"
 #include "Shader.hpp"
 
 #include <iostream>
@@ -127,7 +128,6 @@ void drawCar(Shader& shader, const glm::mat4& model, std::shared_ptr<CuboidMesh>
 
 int main()
 {
-    srand(time(NULL));
     glfwInit();
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
@@ -153,11 +153,15 @@ int main()
     Shader shader("../src/shaders/default.vert", "../src/shaders/default.frag");
     Shader flatShader("../src/shaders/flat.vert", "../src/shaders/flat.frag");
 
-    auto cube = std::make_shared<CuboidMesh>(1.0f, 1.0f, 1.0f);
-    auto cone = std::make_shared<ConeMesh>(20);
-    auto cylinder = std::make_shared<CylinderMesh>(40);
-    auto sphere = std::make_shared<SphereMesh>(20);
-    auto torus = std::make_shared<TorusMesh>(40);
+    ShapeMeshCache meshCache;
+    auto cube = meshCache.cuboid(1.0f, 1.0f, 1.0f);
+    auto cone = meshCache.cone(20);
+    auto cylinder = meshCache.cylinder(40);
+    auto sphere = meshCache.sphere(20);
+    auto torus = meshCache.torus(40);
+    // the ring in the background spans near and far distances: pick its resolution per frame,
+    // geomorphing between levels so they can drop early without popping
+    ShapeMesh ring(buildGridLodChain([](int n) { return generateTorus(n); }, 320, true));
 
     glEnable(GL_DEPTH_TEST);
 
@@ -261,7 +265,7 @@ int main()
             glm::mat4 S = glm::scale(glm::mat4(1.0f), glm::vec3(20.0f, 20.0f, 20.0f));
             flatShader.use();
             flatShader.setModel(T * R * S);
-            torus->draw();
+            ring.draw(view * T * R * S, projection, float(height));
         }
 
         {
@@ -0,0 +1,160 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "glm/glm.hpp"
+
+#include "ProceduralShapeBatch.hpp"
+#include "ShapeMesh.hpp"
+#include "Shader.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+// Procedural shapes against ShapeMesh, in two parts:
+//  check: each kind drawn from its CPU reference (generateProcedural in a ShapeMesh) and from
+//         procedural.vert; the pixels that differ should be a handful along edges. Run it under
+//         a software renderer (e.g. LIBGL_ALWAYS_SOFTWARE=1) to validate without a GPU.
+//  bench: tori of different radii, one TorusMesh each against one ProceduralShapeBatch.
+// Times are wall-clock per frame, glFinish included.
+
+namespace {
+    constexpr int size = 256;
+    constexpr int frames = 20;
+    constexpr int resolution = 48;
+
+    std::vector<unsigned char> readPixels()
+    {
+        std::vector<unsigned char> pixels(size * size * 4);
+        glReadPixels(0, 0, size, size, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        return pixels;
+    }
+
+    glm::mat4 viewOf(float scale)
+    {
+        glm::mat4 view(scale);
+        view[3][3] = 1.0f;
+        view[1][2] = 0.3f * scale; // tilt y into depth so caps and sides both show
+        return view;
+    }
+}
+
+int main()
+{
+    glfwInit();
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    GLFWwindow* window = glfwCreateWindow(size, size, "procedural bench", NULL, NULL);
+    if (window == NULL)
+    {
+        std::printf("Failed to create GLFW window\n");
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+    gladLoadGL();
+    glViewport(0, 0, size, size);
+    glEnable(GL_DEPTH_TEST);
+
+    Shader meshShader("../src/shaders/default.vert", "../src/shaders/default.frag");
+    Shader proceduralShader("../src/shaders/procedural.vert", "../src/shaders/default.frag");
+    for (Shader* shader : { &meshShader, &proceduralShader }) {
+        shader->use();
+        shader->setModel(glm::mat4(1.0f));
+        shader->setView(viewOf(0.6f));
+        shader->setProjection(glm::mat4(1.0f));
+        shader->setMixer(0.0f);
+    }
+
+    std::printf("%10s %16s\n", "kind", "pixels differ");
+    const char* names[] = { "sphere", "torus", "cone", "cylinder" };
+    const ProceduralInstance shapes[] = { proceduralSphere(resolution, 1.0f, 7), proceduralTorus(resolution, 1.0f, 7),
+        proceduralCone(resolution, 1.0f, 7), proceduralCylinder(resolution, 0.8f, 7) };
+    for (int kind = 0; kind < 4; ++kind) {
+        ShapeMesh reference(generateProcedural(shapes[kind]));
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        meshShader.use();
+        reference.draw();
+        const std::vector<unsigned char> expected = readPixels();
+
+        ProceduralShapeBatch batch;
+        batch.add(shapes[kind]);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        proceduralShader.use();
+        batch.draw();
+        const std::vector<unsigned char> actual = readPixels();
+
+        int differ = 0;
+        for (std::size_t p = 0; p < expected.size(); p += 4) {
+            for (int k = 0; k < 3; ++k) {
+                if (std::abs(expected[p + k] - actual[p + k]) > 2) {
+                    ++differ;
+                    break;
+                }
+            }
+        }
+        std::printf("%10s %16d\n", names[kind], differ);
+    }
+
+    for (Shader* shader : { &meshShader, &proceduralShader }) {
+        shader->use();
+        shader->setView(viewOf(0.05f));
+    }
+    std::printf("\n%8s %12s %12s %14s %12s\n", "tori", "build ms", "mesh ms", "vertex bytes", "batch ms");
+    for (int count : { 10, 100, 1000 }) {
+        auto radius = [](int torus) { return 0.3f + 0.001f * torus; };
+        auto offset = [](int torus) { return glm::vec3(float(torus % 32 - 16), float(torus / 32 - 16), 0.0f); };
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::unique_ptr<TorusMesh>> meshes;
+        std::size_t vertexBytes = 0;
+        for (int torus = 0; torus < count; ++torus) {
+            meshes.push_back(std::make_unique<TorusMesh>(resolution, radius(torus), torus));
+            vertexBytes += meshes.back()->vertices.size() * sizeof(GLfloat) + meshes.back()->indices.size() * sizeof(GLuint);
+        }
+        const double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        meshShader.use();
+        start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            for (int torus = 0; torus < count; ++torus) {
+                glm::mat4 model(1.0f);
+                model[3] = glm::vec4(offset(torus), 1.0f);
+                meshShader.setModel(model);
+                meshes[torus]->draw();
+            }
+            glFinish();
+        }
+        const double meshMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+
+        ProceduralShapeBatch batch;
+        for (int torus = 0; torus < count; ++torus) {
+            ProceduralInstance instance = proceduralTorus(resolution, radius(torus), torus);
+            const glm::vec3 position = offset(torus);
+            instance.position[0] = position.x;
+            instance.position[1] = position.y;
+            instance.position[2] = position.z;
+            batch.add(instance);
+        }
+        proceduralShader.use();
+        start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            batch.draw();
+            glFinish();
+        }
+        const double batchMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+
+        std::printf("%8d %12.3f %12.3f %14zu %12.3f\n", count, buildMs, meshMs, vertexBytes, batchMs);
+    }
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return 0;
+}
@@ -8,6 +8,7 @@
 #include "MatrixStack.hpp"
 #include "Texture.hpp"
 #include "ShapeMesh.hpp"
+#include "FixedShapeMesh.hpp"
 #include "Shader.hpp"
 
 #include <iostream>
@@ -41,7 +42,6 @@ static void key_callback(GLFWwindow* window, int key, int scancode, int action,
 
 int main()
 {
-    srand(time(NULL));
     glfwInit();
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
@@ -67,17 +67,18 @@ int main()
     Shader shader("../src/shaders/default.vert", "../src/shaders/default.frag");
     Shader flatShader("../src/shaders/flat.vert", "../src/shaders/flat.frag");
 
-    auto rectangle = std::make_shared<RectangleMesh>(2.0f, 2.0f);
+    // only the cube, sphere and torus are drawn; the rest are built on first draw()
+    auto rectangle = ShapeMesh::deferred([] { return generateRectangle(2.0f, 2.0f); });
     auto cube = std::make_shared<CuboidMesh>(1.0f, 1.0f, 1.0f);
-    auto circle = std::make_shared<CircleMesh>(30);
-    auto cone = std::make_shared<ConeMesh>(20);
-    auto cylinder = std::make_shared<CylinderMesh>(40);
-    auto sphere = std::make_shared<SphereMesh>(20);
+    auto circle = ShapeMesh::deferred([] { return generateCircle(30); });
+    auto cone = ShapeMesh::deferred([] { return generateCone(20); });
+    auto cylinder = ShapeMesh::deferred([] { return generateCylinder(40); });
+    auto sphere = std::make_shared<FixedSphereMesh<20>>();
     auto torus = std::make_shared<TorusMesh>(15);
-    auto starTorus = std::make_shared<StarTorusMesh>(20);
-    auto axes = std::make_shared<CoordinateAxesMesh>();
-    auto poly = std::make_shared<PolynomialMesh>(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, -10.0f, 10.0f, 100, false);
-    auto quadratic = std::make_shared<PolynomialMesh>(0.0f, 1.0f, 0.0f, 0.0f, 7.0f, 0.0f, 0.0f, -2.0f, 5.0f, 100, true);
+    auto starTorus = ShapeMesh::deferred([] { return generateStarTorus(20); });
+    auto axes = ShapeMesh::deferred([] { return generateCoordinateAxes(); });
+    auto poly = ShapeMesh::deferred([] { return generateAdaptivePolynomial({ .r = 1.0f }, -10.0f, 10.0f); });
+    auto quadratic = ShapeMesh::deferred([] { return generateAdaptivePolynomial({ .b = 1.0f, .e = 7.0f, .ySquared = true }, -2.0f, 5.0f); });
 
     MatrixStack matrix;
 
@@ -0,0 +1,89 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "glm/glm.hpp"
+
+#include "TessellatedShapes.hpp"
+#include "Shader.hpp"
+
+#include <cstdio>
+#include <memory>
+
+// Draws each shape at increasing distances and counts the triangles it comes out as, so
+// triangle density can be seen to follow screen size. Asks for a GL 4.0 context for the
+// tessellated path and falls back to 3.3 and cached ShapeMeshes where that fails.
+
+namespace {
+    constexpr int size = 1024;
+
+    GLFWwindow* createWindow(int major, int minor)
+    {
+        glfwDefaultWindowHints();
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, major);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, minor);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        return glfwCreateWindow(size, size, "tessellation demo", NULL, NULL);
+    }
+}
+
+int main()
+{
+    glfwInit();
+    GLFWwindow* window = createWindow(4, 0);
+    if (window == NULL) {
+        window = createWindow(3, 3);
+    }
+    if (window == NULL)
+    {
+        std::printf("Failed to create GLFW window\n");
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+    gladLoadGL();
+    glViewport(0, 0, size, size);
+    glEnable(GL_DEPTH_TEST);
+
+    {
+        const bool tessellated = TessellatedShapes::tessellationSupported();
+        std::unique_ptr<Shader> shader;
+        if (tessellated) {
+            shader = std::make_unique<Shader>("../src/shaders/tessellated.vert", "../src/shaders/tessellated.tesc",
+                "../src/shaders/tessellated.tese", "../src/shaders/default.frag");
+        }
+        else {
+            shader = std::make_unique<Shader>("../src/shaders/default.vert", "../src/shaders/default.frag");
+        }
+        shader->use();
+        shader->setMixer(0.0f);
+        std::printf("path: %s\n", tessellated ? "tessellation" : "ShapeMesh fallback");
+
+        const glm::mat4 projection = glm::perspective(glm::radians(45.0f), 1.0f, 0.1f, 1000.0f);
+        GLuint query;
+        glGenQueries(1, &query);
+
+        const char* names[] = { "sphere", "torus", "cone", "cylinder" };
+        const ProceduralInstance shapes[] = { proceduralSphere(8), proceduralTorus(8, 1.0f), proceduralCone(8), proceduralCylinder(8) };
+        std::printf("%-10s %10s %12s\n", "shape", "distance", "triangles");
+        for (int kind = 0; kind < 4; ++kind) {
+            TessellatedShapes batch(tessellated);
+            batch.add(shapes[kind]);
+            for (float distance : { 2.5f, 5.0f, 10.0f, 20.0f, 40.0f, 80.0f }) {
+                const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.5f * distance, distance), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                glBeginQuery(GL_PRIMITIVES_GENERATED, query);
+                batch.draw(*shader, glm::mat4(1.0f), view, projection, float(size), float(size));
+                glEndQuery(GL_PRIMITIVES_GENERATED);
+                GLuint triangles = 0;
+                glGetQueryObjectuiv(query, GL_QUERY_RESULT, &triangles);
+                std::printf("%-10s %10.1f %12u\n", names[kind], distance, triangles);
+            }
+        }
+        glDeleteQueries(1, &query);
+    }
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return 0;
+}
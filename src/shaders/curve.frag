@@ -0,0 +1,13 @@
+#version 330 core
+
+out vec4 FragColor;
+
+flat in vec3 color;
+flat in float segmentDefined;
+
+void main() {
+    if (segmentDefined < 0.5) {
+        discard; // across a pole or where the curve is undefined
+    }
+    FragColor = vec4(color, 1.0f);
+}
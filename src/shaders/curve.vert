@@ -0,0 +1,57 @@
+#version 330 core
+
+// One instance per curve, no vertex buffer: x steps from low to high with gl_VertexID.
+layout (location = 0) in vec4 aCoefficients; // a, b, c, d
+layout (location = 1) in vec3 aRational;     // e, r, s
+layout (location = 2) in vec2 aRange;        // low, high
+layout (location = 3) in vec4 aCurve;        // generic: samples, ySquared, clip, plot scale
+
+flat out vec3 color;
+flat out float segmentDefined; // the line strip's last vertex provokes, so this covers the segment ending here
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 proj;
+
+bool hasPole() {
+    return aRational.y != 0.0 || aRational.z != 0.0;
+}
+
+// ax^4 + bx^3 + cx^2 + dx + e + r/x + s/x^2 in Horner form. False where the curve is
+// undefined or leaves the plot (GLSL leaves division by zero and sqrt(-1) undefined).
+bool evaluate(float x, out float y) {
+    y = (((aCoefficients.x * x + aCoefficients.y) * x + aCoefficients.z) * x + aCoefficients.w) * x + aRational.x;
+    if (hasPole()) {
+        if (x == 0.0) {
+            return false;
+        }
+        float u = 1.0 / x;
+        y += (aRational.z * u + aRational.y) * u;
+    }
+    if (aCurve.y > 0.5) {
+        if (y < 0.0) {
+            y = 0.0;
+            return false;
+        }
+        y = sqrt(y);
+    }
+    return abs(y * aCurve.w) <= aCurve.z;
+}
+
+void main() {
+    float dx = (aRange.y - aRange.x) / max(aCurve.x - 1.0, 1.0);
+    float x = aRange.x + float(gl_VertexID) * dx;
+    float previousX = x - dx;
+
+    float y;
+    float previousY;
+    bool here = evaluate(x, y);
+    bool previous = gl_VertexID > 0 && evaluate(previousX, previousY);
+    bool crossesPole = hasPole() && previousX < 0.0 && x > 0.0;
+    segmentDefined = here && previous && !crossesPole ? 1.0 : 0.0;
+
+    float limit = aCurve.z / aCurve.w;
+    y = clamp(y, -limit, limit);
+    color = vec3(1.0, 0.0, 0.0);
+    gl_Position = proj * view * model * vec4(x * aCurve.w, y * aCurve.w, 0.0, 1.0);
+}
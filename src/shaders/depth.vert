@@ -0,0 +1,15 @@
+#version 330 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 4) in vec4 aPosScale;
+layout (location = 5) in vec3 aPosBias;
+layout (location = 6) in vec3 aMorph;
+layout (location = 7) in float aMorphFactor;
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 proj;
+
+void main() {
+    gl_Position = proj * view * model * vec4(mix(aPos * aPosScale.xyz + aPosBias, aMorph, aMorphFactor), 1.0);
+}
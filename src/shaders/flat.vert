@@ -4,6 +4,10 @@ layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aCol;
 layout (location = 2) in vec2 aTex;
 layout (location = 3) in vec3 aNor;
+layout (location = 4) in vec4 aPosScale; // xyz: dequantization scale, w: 1 for octahedral normals
+layout (location = 5) in vec3 aPosBias;
+layout (location = 6) in vec3 aMorph;       // geomorphing LODs: position on the next coarser level
+layout (location = 7) in float aMorphFactor;
 
 flat out vec3 color;
 out vec2 texCoord;
@@ -17,12 +21,21 @@ uniform mat4 model;
 uniform mat4 view;
 uniform mat4 proj;
 
+vec3 octahedralDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+}
+
 void main() {
+    vec3 pos = mix(aPos * aPosScale.xyz + aPosBias, aMorph, aMorphFactor);
+
     texCoord = aTex;
-    normCoord = aNor;
+    normCoord = aPosScale.w > 0.5 ? octahedralDecode(aNor.xy) : aNor;
     color = aCol;
-    currentPos = vec3(model * vec4(aPos, 1.0f));
+    currentPos = vec3(model * vec4(pos, 1.0f));
 
-    //gl_Position = vec4(aPos.x + aPos.x*scale, aPos.y + aPos.y*scale, aPos.z + aPos.z*scale, 1.0);
-    gl_Position = proj * view * model * vec4(aPos, 1.0);
+    //gl_Position = vec4(pos.x + pos.x*scale, pos.y + pos.y*scale, pos.z + pos.z*scale, 1.0);
+    gl_Position = proj * view * model * vec4(pos, 1.0);
 }
@@ -0,0 +1,107 @@
+#version 330 core
+
+// One instance per shape, no vertex buffer: the vertex comes from gl_VertexID alone.
+// proceduralVertex() in ProceduralShapes.cpp is the CPU reference for this shader.
+layout (location = 0) in uvec4 aShape;    // kind, columns, rows, colour seed
+layout (location = 1) in vec2 aRadii;     // radius (torus: tube), size (torus: sweep, cone/cylinder: half height)
+layout (location = 2) in vec3 aOffset;
+
+out vec3 color;
+out vec2 texCoord;
+
+out vec3 normCoord;
+out vec3 currentPos;
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 proj;
+
+const float PI = 3.14159265358979;
+const uint SPHERE = 0u;
+const uint TORUS = 1u;
+const uint CONE = 2u;
+
+// Quad corners as (column, row) steps, two counter-clockwise triangles.
+const uint cornerColumn[6] = uint[6](0u, 0u, 1u, 1u, 1u, 0u);
+const uint cornerRow[6] = uint[6](0u, 1u, 1u, 1u, 0u, 0u);
+
+// hashVertex() from VertexRandom.hpp
+float vertexRandom(uint seed, uint vertex, uint channel) {
+    uint x = (vertex * 4u + channel) * 0x9E3779B9u + seed * 0x85EBCA6Bu;
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return float(x >> 8) * (1.0 / 16777216.0);
+}
+
+void main() {
+    uint kind = aShape.x;
+    uint columns = aShape.y;
+    uint rows = aShape.z;
+
+    uint id = uint(gl_VertexID);
+    uint quad = id / 6u;
+    uint corner = id % 6u;
+    uint column = quad % columns + cornerColumn[corner];
+    uint row = quad / columns;
+    uint rowStep = cornerRow[corner];
+
+    float u = float(column) / float(columns);
+    float v = float(row + rowStep) / float(rows);
+    float theta = 2.0 * PI * u;
+    float c = cos(theta);
+    float s = sin(theta);
+    float r = aRadii.x;
+    float h = aRadii.y;
+
+    vec3 pos;
+    vec3 normal;
+    if (kind == SPHERE) {
+        float phi = PI * v;
+        normal = vec3(sin(phi) * c, sin(phi) * s, cos(phi));
+        pos = r * normal;
+    }
+    else if (kind == TORUS) {
+        float alpha = 2.0 * PI * v;
+        normal = vec3(c * cos(alpha), c * sin(alpha), s);
+        pos = vec3((h + r * c) * cos(alpha), (h + r * c) * sin(alpha), r * s);
+    }
+    else {
+        // caps fan out from their centre; cone sides close in on the apex
+        bool cone = kind == CONE;
+        bool bottom = row == 0u;
+        bool top = !cone && row == rows - 1u;
+        float ring;
+        float y;
+        if (bottom) {
+            ring = r * float(rowStep);
+            y = -h;
+        }
+        else if (top) {
+            ring = r * float(1u - rowStep);
+            y = h;
+        }
+        else {
+            ring = cone ? r * float(1u - rowStep) : r;
+            y = rowStep != 0u ? h : -h;
+        }
+        pos = vec3(ring * c, y, ring * s);
+        if (bottom || top) {
+            normal = vec3(0.0, bottom ? -1.0 : 1.0, 0.0);
+        }
+        else {
+            float slope = cone ? r / (2.0 * h) : 0.0;
+            normal = vec3(c, slope, s) / sqrt(1.0 + slope * slope);
+        }
+    }
+    pos += aOffset;
+
+    uint gridVertex = column % columns + (row + rowStep) * columns;
+    color = vec3(vertexRandom(aShape.w, gridVertex, 0u), vertexRandom(aShape.w, gridVertex, 1u), vertexRandom(aShape.w, gridVertex, 2u));
+    texCoord = vec2(u, v);
+    normCoord = normal;
+    currentPos = vec3(model * vec4(pos, 1.0));
+    gl_Position = proj * view * model * vec4(pos, 1.0);
+}
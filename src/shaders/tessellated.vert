@@ -0,0 +1,84 @@
+#version 400 core
+
+// One instance per shape, four vertices per coarse grid quad and no vertex buffer: each
+// vertex is a patch corner. The evaluation shader places the tessellated vertices.
+layout (location = 0) in uvec4 aShape;    // kind, columns, rows, colour seed
+layout (location = 1) in vec2 aRadii;     // as in procedural.vert
+layout (location = 2) in vec3 aOffset;
+
+out vec3 vPos;               // the corner on the surface, for the control shader's edge lengths
+out vec3 vColor;
+out float vU;                // unwrapped, so the last column ends at 1
+flat out uvec4 vShape;       // kind, columns, rows, the patch's row
+flat out vec2 vRadii;
+flat out vec3 vOffset;
+
+const float PI = 3.14159265358979;
+const uint SPHERE = 0u;
+const uint TORUS = 1u;
+const uint CONE = 2u;
+
+// Patch corners counter-clockwise in (column, row).
+const uint cornerColumn[4] = uint[4](0u, 1u, 1u, 0u);
+const uint cornerRow[4] = uint[4](0u, 0u, 1u, 1u);
+
+// hashVertex() from VertexRandom.hpp
+float vertexRandom(uint seed, uint vertex, uint channel) {
+    uint x = (vertex * 4u + channel) * 0x9E3779B9u + seed * 0x85EBCA6Bu;
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return float(x >> 8) * (1.0 / 16777216.0);
+}
+
+// Same surfaces as procedural.vert, with rowStep the fraction of the way through row.
+vec3 surface(float u, uint row, float rowStep) {
+    uint kind = aShape.x;
+    uint rows = aShape.z;
+    float v = (float(row) + rowStep) / float(rows);
+    float theta = 2.0 * PI * u;
+    float c = cos(theta);
+    float s = sin(theta);
+    float r = aRadii.x;
+    float h = aRadii.y;
+
+    if (kind == SPHERE) {
+        float phi = PI * v;
+        return r * vec3(sin(phi) * c, sin(phi) * s, cos(phi));
+    }
+    if (kind == TORUS) {
+        float alpha = 2.0 * PI * v;
+        return vec3((h + r * c) * cos(alpha), (h + r * c) * sin(alpha), r * s);
+    }
+    bool bottom = row == 0u;
+    bool top = kind != CONE && row == rows - 1u;
+    if (bottom) {
+        return vec3(r * rowStep * c, -h, r * rowStep * s);
+    }
+    if (top) {
+        return vec3(r * (1.0 - rowStep) * c, h, r * (1.0 - rowStep) * s);
+    }
+    float ring = kind == CONE ? r * (1.0 - rowStep) : r;
+    return vec3(ring * c, mix(-h, h, rowStep), ring * s);
+}
+
+void main() {
+    uint columns = aShape.y;
+    uint id = uint(gl_VertexID);
+    uint quad = id / 4u;
+    uint corner = id % 4u;
+    uint column = quad % columns + cornerColumn[corner];
+    uint row = quad / columns;
+    uint rowStep = cornerRow[corner];
+
+    // the wrapped column evaluates like column 0, so neighbouring patches agree on the seam
+    vPos = surface(float(column % columns) / float(columns), row, float(rowStep)) + aOffset;
+    uint gridVertex = column % columns + (row + rowStep) * columns;
+    vColor = vec3(vertexRandom(aShape.w, gridVertex, 0u), vertexRandom(aShape.w, gridVertex, 1u), vertexRandom(aShape.w, gridVertex, 2u));
+    vU = float(column) / float(columns);
+    vShape = uvec4(aShape.xyz, row);
+    vRadii = aRadii;
+    vOffset = aOffset;
+}